@@ -0,0 +1,54 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/AnalyticsResource.h"
+
+AnalyticsResource::AnalyticsResource(const Tournament &tournament)
+    : tournament(tournament) {
+  setTakesUpdateLock(true);
+  suggestFileName("racingweb-analytics.csv");
+}
+
+AnalyticsResource::~AnalyticsResource() { beingDeleted(); }
+
+void AnalyticsResource::handleRequest(const Wt::Http::Request &request,
+                                      Wt::Http::Response &response) {
+  response.setMimeType("text/csv");
+  auto &out = response.out();
+
+  // lane totals per division, since divisions may differ in lanes
+  out << "division,lane,races,wins,win_rate,win_rate_low,win_rate_high,"
+         "average_place,average_place_margin,biased\n";
+  for (const auto &division : tournament.Divisions()) {
+    const auto &lanes = division->analytics.Lanes();
+    for (int lane = 0; lane < lanes.size(); lane++) {
+      double low, high;
+      lanes[lane].WinRateInterval(low, high);
+      out << division->name << "," << lane + 1 << "," << lanes[lane].races
+          << "," << lanes[lane].wins << "," << lanes[lane].WinRate() << ","
+          << low << "," << high << "," << lanes[lane].AveragePlace() << ","
+          << lanes[lane].AveragePlaceMargin() << ","
+          << (lanes[lane].IsBiased(static_cast<int>(lanes.size())) ? 1 : 0)
+          << "\n";
+    }
+  }
+
+  // every pair of cars that has raced each other
+  out << "\ndivision,car,opponent,wins,losses,meetings\n";
+  for (const auto &division : tournament.Divisions()) {
+    const auto &analytics = division->analytics;
+    for (int a = 0; a < analytics.Cars(); a++) {
+      for (int b = 0; b < analytics.Cars(); b++) {
+        if (a == b || analytics.Meetings(a, b) == 0) {
+          continue;
+        }
+        out << division->name << "," << division->roster[a].number << ","
+            << division->roster[b].number << "," << analytics.Wins(a, b)
+            << "," << analytics.Wins(b, a) << "," << analytics.Meetings(a, b)
+            << "\n";
+      }
+    }
+  }
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_ANALYTICSRESOURCE_H_
+#define RACINGWEB_SRC_ANALYTICSRESOURCE_H_
+
+#include <Wt/Http/Request.h>
+#include <Wt/Http/Response.h>
+#include <Wt/WResource.h>
+
+#include "src/RaceAnalytics.h"
+#include "src/Tournament.h"
+
+/**
+ * @brief exports a session's lane and head-to-head statistics as csv
+ *
+ * Owned by the session, and takes the session's update lock while writing so
+ * the statistics cannot change mid-export.
+ */
+class AnalyticsResource : public Wt::WResource {
+ public:
+  /**
+   * @brief create an export for a tournament
+   * @param tournament the tournament to export, must outlive the resource
+   */
+  explicit AnalyticsResource(const Tournament &tournament);
+
+  ~AnalyticsResource() override;
+
+  /**
+   * @brief write the lane statistics followed by every rivalry
+   * @param request the download request (unused)
+   * @param response receives the csv
+   */
+  void handleRequest(const Wt::Http::Request &request,
+                     Wt::Http::Response &response) override;
+
+ private:
+  /// @brief the tournament to export
+  const Tournament &tournament;
+};
+
+#endif  // RACINGWEB_SRC_ANALYTICSRESOURCE_H_
@@ -0,0 +1,131 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/EventTimeline.h"
+
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+void EventTimeline::Reset(const int heats) {
+  timings = std::vector<HeatTiming>(heats);
+  accept_order = std::vector<int>();
+  race_started = Clock::time_point();
+}
+
+void EventTimeline::Extend(const int heats) {
+  timings.resize(timings.size() + heats);
+}
+
+void EventTimeline::HeatStarted(const int heat, const Clock::time_point now) {
+  if (race_started == Clock::time_point()) {
+    race_started = now;
+  }
+  timings[heat].started = now;
+}
+
+void EventTimeline::ResultEntered(const int heat, const Clock::time_point now) {
+  if (timings[heat].first_result == Clock::time_point()) {
+    timings[heat].first_result = now;
+  }
+  timings[heat].last_result = now;
+}
+
+void EventTimeline::HeatAccepted(const int heat, const Clock::time_point now) {
+  timings[heat].accepted = now;
+  accept_order.emplace_back(heat);
+}
+
+double EventTimeline::HeatsPerHour() const {
+  if (accept_order.empty()) {
+    return 0;
+  }
+
+  // measure from the accept just before the window, or from the start of the
+  // race while fewer heats than the window have been run
+  auto heats = static_cast<int>(accept_order.size());
+  auto window = heats < kRollingHeats ? heats : kRollingHeats;
+  auto origin = heats > window
+                    ? timings[accept_order[heats - window - 1]].accepted
+                    : race_started;
+  auto hours = std::chrono::duration<double, std::ratio<3600>>(
+      timings[accept_order.back()].accepted - origin);
+  if (hours.count() <= 0) {
+    return 0;
+  }
+  return window / hours.count();
+}
+
+EventTimeline::Clock::duration EventTimeline::Dwell(const int heat) const {
+  if (timings[heat].accepted == Clock::time_point() ||
+      timings[heat].last_result == Clock::time_point()) {
+    return Clock::duration::zero();
+  }
+  return timings[heat].accepted - timings[heat].last_result;
+}
+
+EventTimeline::Clock::duration EventTimeline::LastDwell() const {
+  if (accept_order.empty()) {
+    return Clock::duration::zero();
+  }
+  return Dwell(accept_order.back());
+}
+
+EventTimeline::Clock::duration EventTimeline::AverageDwell() const {
+  if (accept_order.empty()) {
+    return Clock::duration::zero();
+  }
+  auto total{Clock::duration::zero()};
+  for (const auto &heat : accept_order) {
+    total += Dwell(heat);
+  }
+  return total / accept_order.size();
+}
+
+EventTimeline::Clock::duration EventTimeline::Elapsed() const {
+  if (accept_order.empty()) {
+    return Clock::duration::zero();
+  }
+  return timings[accept_order.back()].accepted - race_started;
+}
+
+EventTimeline::Clock::duration EventTimeline::Remaining(
+    const int heats_remaining) const {
+  auto rate = HeatsPerHour();
+  if (rate <= 0) {
+    return Clock::duration::zero();
+  }
+  return std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::ratio<3600>>(heats_remaining / rate));
+}
+
+std::string FormatDuration(const std::chrono::steady_clock::duration duration) {
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
+  auto total = seconds.count() < 0 ? 0 : seconds.count();
+
+  auto text{std::stringstream()};
+  if (total >= 3600) {
+    text << total / 3600 << ":" << std::setw(2) << std::setfill('0')
+         << total / 60 % 60;
+  } else {
+    text << total / 60;
+  }
+  text << ":" << std::setw(2) << std::setfill('0') << total % 60;
+  return text.str();
+}
+
+std::string FormatClockTimeFromNow(
+    const std::chrono::steady_clock::duration from_now) {
+  auto when = std::chrono::system_clock::to_time_t(
+      std::chrono::system_clock::now() +
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          from_now));
+  std::tm local{};
+  localtime_r(&when, &local);
+
+  auto text{std::stringstream()};
+  text << std::put_time(&local, "%H:%M");
+  return text.str();
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_EVENTTIMELINE_H_
+#define RACINGWEB_SRC_EVENTTIMELINE_H_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/// @brief when each step of a single heat happened
+struct HeatTiming {
+  /// @brief when the heat's lineup was shown on the run tab
+  std::chrono::steady_clock::time_point started;
+  /// @brief when the first place was marked
+  std::chrono::steady_clock::time_point first_result;
+  /// @brief when the most recent place was marked
+  std::chrono::steady_clock::time_point last_result;
+  /// @brief when the results were accepted
+  std::chrono::steady_clock::time_point accepted;
+};
+
+/**
+ * @brief timestamps every heat of a race and projects when it will finish
+ *
+ * A default constructed time point in a HeatTiming means that step has not
+ * happened yet.
+ */
+class EventTimeline {
+ public:
+  /// @brief clock used for every timestamp
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief how many recently accepted heats the rolling rate covers
+  static constexpr int kRollingHeats = 5;
+
+  /**
+   * @brief forget all timings and prepare for a new race
+   * @param heats number of heats in the new race
+   */
+  void Reset(int heats);
+
+  /**
+   * @brief add heats to the end of the race, keeping recorded timings
+   * @param heats number of heats to add
+   */
+  void Extend(int heats);
+
+  /**
+   * @brief record that a heat's lineup is now shown
+   * @param heat the heat, 0 <= heat < number of heats
+   * @param now when it was shown
+   */
+  void HeatStarted(int heat, Clock::time_point now = Clock::now());
+
+  /**
+   * @brief record that a place was marked in a heat
+   * @param heat the heat, 0 <= heat < number of heats
+   * @param now when it was marked
+   */
+  void ResultEntered(int heat, Clock::time_point now = Clock::now());
+
+  /**
+   * @brief record that a heat's results were accepted
+   * @param heat the heat, 0 <= heat < number of heats
+   * @param now when they were accepted
+   */
+  void HeatAccepted(int heat, Clock::time_point now = Clock::now());
+
+  /**
+   * @brief heats accepted per hour over the last kRollingHeats heats
+   * @return the rate, or 0 if no heat has been accepted yet
+   */
+  [[nodiscard]] double HeatsPerHour() const;
+
+  /**
+   * @brief how long results sat complete before the operator accepted them
+   * @param heat the heat, 0 <= heat < number of heats
+   * @return the dwell time, or zero if the heat has not been accepted
+   */
+  [[nodiscard]] Clock::duration Dwell(int heat) const;
+
+  /**
+   * @brief dwell time of the most recently accepted heat
+   * @return the dwell time, or zero if no heat has been accepted yet
+   */
+  [[nodiscard]] Clock::duration LastDwell() const;
+
+  /**
+   * @brief average dwell time over every accepted heat
+   * @return the average, or zero if no heat has been accepted yet
+   */
+  [[nodiscard]] Clock::duration AverageDwell() const;
+
+  /**
+   * @brief time from the first heat starting to the last accept
+   * @return the elapsed time, or zero if no heat has been accepted yet
+   */
+  [[nodiscard]] Clock::duration Elapsed() const;
+
+  /**
+   * @brief estimate how long the remaining heats will take
+   * @param heats_remaining heats not yet accepted, including the current one
+   * @return the estimate, or zero if no rate is known yet
+   */
+  [[nodiscard]] Clock::duration Remaining(int heats_remaining) const;
+
+  /// @brief number of heats accepted so far
+  [[nodiscard]] int HeatsAccepted() const {
+    return static_cast<int>(accept_order.size());
+  }
+
+ private:
+  /// @brief timings indexed by heat
+  std::vector<HeatTiming> timings;
+
+  /// @brief heats in the order they were accepted
+  std::vector<int> accept_order;
+
+  /// @brief when the first heat was shown
+  Clock::time_point race_started;
+};
+
+/**
+ * @brief format a duration for display
+ * @param duration the duration to format
+ * @return "m:ss" or "h:mm:ss"
+ */
+std::string FormatDuration(std::chrono::steady_clock::duration duration);
+
+/**
+ * @brief format a wall clock time a duration from now
+ * @param from_now how far in the future
+ * @return local time as "HH:MM"
+ */
+std::string FormatClockTimeFromNow(std::chrono::steady_clock::duration from_now);
+
+#endif  // RACINGWEB_SRC_EVENTTIMELINE_H_
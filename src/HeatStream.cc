@@ -0,0 +1,100 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/HeatStream.h"
+
+#include <algorithm>
+#include <numeric>
+
+HeatStream::HeatStream(const std::vector<Car> &roster, const int lanes,
+                       const int rounds)
+    : roster(roster),
+      cars(static_cast<int>(roster.size())),
+      lanes(std::min(lanes, static_cast<int>(roster.size()))),
+      rounds(rounds) {
+  // a stride works if the lanes land on distinct cars
+  auto usable = std::vector<int>();
+  for (int stride = 1; stride <= cars / 2 || stride == 1; stride++) {
+    if (cars / std::gcd(stride, cars) >= this->lanes) {
+      usable.emplace_back(stride);
+    }
+  }
+
+  // two cars meet when their distance around the roster is a multiple of
+  // the stride below lanes * stride.  pick each round's stride so those
+  // distances are new, falling back to the least repeated when small rosters
+  // run out of fresh opponents.
+  auto met = std::vector<bool>(cars);
+  auto distances = [this](const int stride) {
+    auto distance_list = std::vector<int>();
+    for (int lane = 1; lane < this->lanes; lane++) {
+      distance_list.emplace_back(lane * stride % cars);
+      distance_list.emplace_back((cars - lane * stride % cars) % cars);
+    }
+    return distance_list;
+  };
+  for (int round = 0; round < rounds; round++) {
+    auto best_stride{usable[round % usable.size()]};
+    auto best_repeats{cars * 2 + 1};
+    for (const auto &stride : usable) {
+      auto repeats{0};
+      for (const auto &distance : distances(stride)) {
+        repeats += met[distance];
+      }
+      if (repeats < best_repeats) {
+        best_stride = stride;
+        best_repeats = repeats;
+      }
+      if (repeats == 0) {
+        break;
+      }
+    }
+    for (const auto &distance : distances(best_stride)) {
+      met[distance] = true;
+    }
+    strides.emplace_back(best_stride);
+  }
+}
+
+std::vector<const Car *> HeatStream::Next() {
+  RACINGWEB_TRACE_SCOPE("HeatStream::Next");
+
+  // keep enough heats in view to step past every heat sharing a car with
+  // the previous one in a plain rotation
+  auto window_size = static_cast<size_t>(2 * lanes + 1);
+  while (window.size() < window_size && next_rotation < Size()) {
+    window.emplace_back(RotationHeat(next_rotation / cars,
+                                     next_rotation % cars));
+    next_rotation++;
+  }
+
+  if (window.empty()) {
+    return std::vector<const Car *>();
+  }
+
+  // prefer the first heat with no car from the previous heat
+  size_t next_heat{0};
+  for (size_t proposed_idx = 0; proposed_idx < window.size(); proposed_idx++) {
+    if (!DoAnyCarsMatch(previous, window[proposed_idx])) {
+      next_heat = proposed_idx;
+      break;
+    }
+  }
+
+  previous = window[next_heat];
+  window.erase(window.begin() + next_heat);
+  generated++;
+  return previous;
+}
+
+std::vector<const Car *> HeatStream::RotationHeat(const int round,
+                                                  const int heat) const {
+  auto rotation_heat{std::vector<const Car *>()};
+  for (int lane = 0; lane < lanes; lane++) {
+    rotation_heat.emplace_back(
+        &roster[(heat + lane * strides[round]) % cars]);
+  }
+  return rotation_heat;
+}
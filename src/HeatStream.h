@@ -0,0 +1,87 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_HEATSTREAM_H_
+#define RACINGWEB_SRC_HEATSTREAM_H_
+
+#include <deque>
+#include <vector>
+
+#include "src/Car.h"
+#include "src/raceutil.h"
+#include "src/trace.h"
+
+/**
+ * @brief generates a multi-round schedule one heat at a time
+ *
+ * Each round is a rotation where car (heat + lane * stride) races in lane
+ * lane, so every car races once in every lane per round.  Each round uses a
+ * different stride, which gives every car different opponents from round to
+ * round.  Heats are handed out in rotation order, except that the next heat
+ * is picked from a small window of upcoming heats to try and avoid a car
+ * racing in two heats in a row.  Only that window is ever held in memory.
+ */
+class HeatStream {
+ public:
+  /**
+   * @brief prepare a stream without generating any heats yet
+   * @param roster the cars to race, must not be empty; heats point into it, so
+   * it must outlive the stream and not be resized
+   * @param lanes number of lanes, 0 < lanes, capped at roster.size()
+   * @param rounds how many times each car races in each lane, 0 < rounds
+   */
+  HeatStream(const std::vector<Car> &roster, int lanes, int rounds);
+
+  /**
+   * @brief generate the next heat
+   * @return one car per lane, or an empty heat once every heat was generated
+   */
+  std::vector<const Car *> Next();
+
+  /// @brief total number of heats across every round
+  [[nodiscard]] int Size() const { return cars * rounds; }
+
+  /// @brief number of heats generated so far
+  [[nodiscard]] int Generated() const { return generated; }
+
+ private:
+  /**
+   * @brief build a heat from its round and rotation
+   * @param round the round, 0 <= round < rounds
+   * @param heat position in the round's rotation, 0 <= heat < cars
+   * @return one car per lane
+   */
+  [[nodiscard]] std::vector<const Car *> RotationHeat(int round,
+                                                      int heat) const;
+
+  /// @brief the cars being raced
+  const std::vector<Car> &roster;
+
+  /// @brief number of cars on the roster
+  int cars;
+
+  /// @brief number of lanes, capped at cars
+  int lanes;
+
+  /// @brief number of rounds
+  int rounds;
+
+  /// @brief distance between the cars in neighbouring lanes, per round
+  std::vector<int> strides;
+
+  /// @brief upcoming heats the next heat is picked from
+  std::deque<std::vector<const Car *>> window;
+
+  /// @brief position of the next heat to add to the window
+  int next_rotation = 0;
+
+  /// @brief the most recently generated heat
+  std::vector<const Car *> previous;
+
+  /// @brief number of heats generated so far
+  int generated = 0;
+};
+
+#endif  // RACINGWEB_SRC_HEATSTREAM_H_
@@ -0,0 +1,14 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/MetricsResource.h"
+
+MetricsResource::~MetricsResource() { beingDeleted(); }
+
+void MetricsResource::handleRequest(const Wt::Http::Request &request,
+                                    Wt::Http::Response &response) {
+  response.setMimeType("text/plain; version=0.0.4");
+  WriteMetrics(response.out());
+}
@@ -0,0 +1,33 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_METRICSRESOURCE_H_
+#define RACINGWEB_SRC_METRICSRESOURCE_H_
+
+#include <Wt/Http/Request.h>
+#include <Wt/Http/Response.h>
+#include <Wt/WResource.h>
+
+#include "src/metrics.h"
+
+/**
+ * @brief serves the server's metrics in the prometheus text format
+ *
+ * Mounted as a static resource, so scraping does not create a session.
+ */
+class MetricsResource : public Wt::WResource {
+ public:
+  ~MetricsResource() override;
+
+  /**
+   * @brief write the current metrics
+   * @param request the scrape request (unused)
+   * @param response receives the metrics
+   */
+  void handleRequest(const Wt::Http::Request &request,
+                     Wt::Http::Response &response) override;
+};
+
+#endif  // RACINGWEB_SRC_METRICSRESOURCE_H_
@@ -0,0 +1,114 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/RaceAnalytics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// @brief z score of a two sided 95% confidence interval
+constexpr double kZ95 = 1.959964;
+
+}  // namespace
+
+double LaneStats::WinRate() const {
+  return races > 0 ? static_cast<double>(wins) / races : 0.0;
+}
+
+void LaneStats::WinRateInterval(double &low, double &high) const {
+  if (races == 0) {
+    low = 0;
+    high = 1;
+    return;
+  }
+  auto n = static_cast<double>(races);
+  auto p = WinRate();
+  auto z2 = kZ95 * kZ95;
+  auto center = (p + z2 / (2 * n)) / (1 + z2 / n);
+  auto margin =
+      kZ95 * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / (1 + z2 / n);
+  low = std::max(0.0, center - margin);
+  high = std::min(1.0, center + margin);
+}
+
+double LaneStats::AveragePlace() const {
+  return races > 0 ? static_cast<double>(place_sum) / races + 1 : 0.0;
+}
+
+double LaneStats::AveragePlaceMargin() const {
+  if (races < 2) {
+    return 0;
+  }
+  auto n = static_cast<double>(races);
+  auto mean = place_sum / n;
+  auto variance = std::max(0.0, (place_squares - n * mean * mean) / (n - 1));
+  return kZ95 * std::sqrt(variance / n);
+}
+
+bool LaneStats::IsBiased(const int lanes) const {
+  double low, high;
+  WinRateInterval(low, high);
+  auto expected = 1.0 / lanes;
+  return races > 0 && (expected < low || expected > high);
+}
+
+void RaceAnalytics::Reset(const int lanes, const int cars) {
+  this->cars = cars;
+  lane_stats = std::vector<LaneStats>(lanes);
+  rivalries = std::vector<Rivalry>(
+      static_cast<size_t>(cars) * (cars > 0 ? cars - 1 : 0) / 2);
+}
+
+void RaceAnalytics::RecordHeat(const std::vector<Car> &roster,
+                               const HeatResults &heat) {
+  for (int lane = 0; lane < heat.size() && lane < lane_stats.size(); lane++) {
+    if (!heat[lane]) {
+      continue;
+    }
+    auto &stats = lane_stats[lane];
+    auto place = heat[lane]->place;
+    stats.races++;
+    stats.wins += place == 0;
+    stats.place_sum += place;
+    stats.place_squares += place * place;
+  }
+
+  for (int i = 0; i < heat.size(); i++) {
+    for (int j = i + 1; j < heat.size(); j++) {
+      if (!heat[i] || !heat[j]) {
+        continue;
+      }
+      auto a = static_cast<int>(heat[i]->car - roster.data());
+      auto b = static_cast<int>(heat[j]->car - roster.data());
+      if (a == b) {
+        continue;
+      }
+      auto &rivalry = rivalries[RivalryIndex(a, b)];
+      rivalry.meetings++;
+      auto lower_ahead = a < b ? heat[i]->place < heat[j]->place
+                               : heat[j]->place < heat[i]->place;
+      rivalry.lower_wins += lower_ahead;
+    }
+  }
+}
+
+int RaceAnalytics::Wins(const int a, const int b) const {
+  const auto &rivalry = rivalries[RivalryIndex(a, b)];
+  return a < b ? rivalry.lower_wins : rivalry.meetings - rivalry.lower_wins;
+}
+
+int RaceAnalytics::Meetings(const int a, const int b) const {
+  return rivalries[RivalryIndex(a, b)].meetings;
+}
+
+size_t RaceAnalytics::RivalryIndex(int a, int b) const {
+  if (a > b) {
+    std::swap(a, b);
+  }
+  // rows of the upper triangle get one shorter each time
+  return static_cast<size_t>(a) * (2 * cars - a - 1) / 2 + (b - a - 1);
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_RACEANALYTICS_H_
+#define RACINGWEB_SRC_RACEANALYTICS_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "src/Car.h"
+#include "src/Result.h"
+
+/// @brief running totals of how cars finish in one lane
+struct LaneStats {
+  /// @brief heats raced in this lane
+  int races = 0;
+  /// @brief first place finishes in this lane
+  int wins = 0;
+  /// @brief sum of 0-based places, for the average place
+  int64_t place_sum = 0;
+  /// @brief sum of squared 0-based places, for the place variance
+  int64_t place_squares = 0;
+
+  /**
+   * @brief add another lane's totals to this one
+   * @param other totals to add
+   */
+  void Merge(const LaneStats &other) {
+    races += other.races;
+    wins += other.wins;
+    place_sum += other.place_sum;
+    place_squares += other.place_squares;
+  }
+
+  /**
+   * @brief share of races won in this lane
+   * @return win rate, 0 when no races have been run
+   */
+  [[nodiscard]] double WinRate() const;
+
+  /**
+   * @brief 95% wilson score interval of the win rate
+   * @param low receives the lower bound
+   * @param high receives the upper bound
+   */
+  void WinRateInterval(double &low, double &high) const;
+
+  /**
+   * @brief average 1-based finishing place in this lane
+   * @return average place, 0 when no races have been run
+   */
+  [[nodiscard]] double AveragePlace() const;
+
+  /**
+   * @brief half width of the 95% confidence interval of the average place
+   * @return the margin, 0 with fewer than two races
+   */
+  [[nodiscard]] double AveragePlaceMargin() const;
+
+  /**
+   * @brief check whether this lane wins more or less often than chance
+   * @param lanes number of lanes on the track
+   * @return true if the win rate interval excludes 1 / lanes
+   */
+  [[nodiscard]] bool IsBiased(int lanes) const;
+};
+
+/**
+ * @brief streaming lane and head-to-head statistics for one division
+ *
+ * Every accepted heat is folded in once, costing O(lanes) for the lane totals
+ * and O(lanes^2) for the rivalries between the cars in the heat.  Rivalries
+ * only store the upper triangle of the car matrix, with 16 bit counters.
+ */
+class RaceAnalytics {
+ public:
+  /**
+   * @brief forget everything and size the statistics for a new race
+   * @param lanes number of lanes
+   * @param cars number of cars on the roster
+   */
+  void Reset(int lanes, int cars);
+
+  /**
+   * @brief fold the results of an accepted heat into the statistics
+   * @param roster the roster the results point into
+   * @param heat complete results of one heat, indexed by lane
+   */
+  void RecordHeat(const std::vector<Car> &roster, const HeatResults &heat);
+
+  /// @brief totals for each lane
+  [[nodiscard]] const std::vector<LaneStats> &Lanes() const {
+    return lane_stats;
+  }
+
+  /// @brief number of cars on the roster
+  [[nodiscard]] int Cars() const { return cars; }
+
+  /**
+   * @brief how many times one car finished ahead of another
+   * @param a roster index of the car
+   * @param b roster index of the opponent, a != b
+   * @return heats where a finished ahead of b
+   */
+  [[nodiscard]] int Wins(int a, int b) const;
+
+  /**
+   * @brief how many heats two cars raced against each other
+   * @param a roster index of one car
+   * @param b roster index of the other car, a != b
+   * @return shared heats
+   */
+  [[nodiscard]] int Meetings(int a, int b) const;
+
+ private:
+  /// @brief results between two cars, seen from the lower roster index
+  struct Rivalry {
+    /// @brief heats the lower roster index finished ahead
+    uint16_t lower_wins = 0;
+    /// @brief heats raced against each other
+    uint16_t meetings = 0;
+  };
+
+  /**
+   * @brief position of a pair of cars in the upper triangle
+   * @param a roster index of one car
+   * @param b roster index of the other car, a != b
+   * @return index into rivalries
+   */
+  [[nodiscard]] size_t RivalryIndex(int a, int b) const;
+
+  /// @brief totals for each lane
+  std::vector<LaneStats> lane_stats;
+
+  /// @brief upper triangle of the head-to-head matrix
+  std::vector<Rivalry> rivalries;
+
+  /// @brief number of cars on the roster
+  int cars = 0;
+};
+
+#endif  // RACINGWEB_SRC_RACEANALYTICS_H_
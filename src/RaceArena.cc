@@ -0,0 +1,50 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/RaceArena.h"
+
+#include "src/metrics.h"
+
+void RaceArena::Release() {
+  pool.release();
+  monotonic.release();
+}
+
+void *RaceArena::do_allocate(const size_t bytes, const size_t alignment) {
+  allocations++;
+  IncrementCounter(Counter::kArenaAllocations);
+  return pool.allocate(bytes, alignment);
+}
+
+void RaceArena::do_deallocate(void *p, const size_t bytes,
+                              const size_t alignment) {
+  pool.deallocate(p, bytes, alignment);
+}
+
+bool RaceArena::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+void *RaceArena::ChunkSource::do_allocate(const size_t bytes,
+                                          const size_t alignment) {
+  auto p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  this->bytes += bytes;
+  IncrementCounter(Counter::kArenaChunks);
+  AdjustGauge(Gauge::kArenaBytes, static_cast<int64_t>(bytes));
+  return p;
+}
+
+void RaceArena::ChunkSource::do_deallocate(void *p, const size_t bytes,
+                                           const size_t alignment) {
+  std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  this->bytes -= bytes;
+  AdjustGauge(Gauge::kArenaBytes, -static_cast<int64_t>(bytes));
+}
+
+bool RaceArena::ChunkSource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
@@ -16,21 +16,48 @@ RacingWebApplication::RacingWebApplication(const Wt::WEnvironment &env)
   setup_tab = tabs->addTab(BuildSetupContainer(), "Setup");
   run_tab = tabs->addTab(BuildRunContainer(), "Run");
   standings_tab = tabs->addTab(BuildStandingsContainer(), "Standings");
+  analytics_tab = tabs->addTab(BuildAnalyticsContainer(), "Analytics");
 
   // start with the setup tab visible, and others disabled
   setup_tab->select();
   run_tab->disable();
   standings_tab->disable();
+  analytics_tab->disable();
+
+  // the analytics tab is rebuilt when it is opened, not on every accept
+  tabs->currentChanged().connect([this](int index) {
+    if (analytics_stale && tabs->itemAt(index) == analytics_tab) {
+      UpdateAnalyticsContainer();
+    }
+  });
+
+  AdjustGauge(Gauge::kActiveSessions, 1);
+}
+
+RacingWebApplication::~RacingWebApplication() {
+  if (race_in_progress) {
+    AdjustGauge(Gauge::kActiveRaces, -1);
+  }
+  AdjustGauge(Gauge::kActiveSessions, -1);
 }
 
 void RacingWebApplication::GenerateSchedule() {
-  int cars, lanes;
+  RACINGWEB_TRACE_SCOPE("GenerateSchedule");
+  auto latency = ScopedLatency(Histogram::kScheduleGeneration);
+  auto division_cars{std::vector<int>()};
+  int lanes, rounds;
 
+  // number_of_cars holds one count, or a comma separated count per division
   // failure to parse is likely the result of an accidental button click
   // just ignore it
   try {
-    cars = std::stoi(number_of_cars->text());
+    auto cars_list{std::stringstream(number_of_cars->text().toUTF8())};
+    auto cars_item{std::string()};
+    while (std::getline(cars_list, cars_item, ',')) {
+      division_cars.emplace_back(std::stoi(cars_item));
+    }
     lanes = std::stoi(number_of_lanes->text());
+    rounds = std::stoi(number_of_rounds->text());
   } catch (std::invalid_argument const &invalid_argument) {
     return;
   } catch (std::out_of_range const &out_of_range) {
@@ -38,92 +65,127 @@ void RacingWebApplication::GenerateSchedule() {
   }
 
   // non-positive values are treated the same way
-  if (cars < 1 || lanes < 1) {
+  if (division_cars.empty() || lanes < 1 || rounds < 1 ||
+      std::any_of(division_cars.begin(), division_cars.end(),
+                  [](const auto &cars) { return cars < 1; })) {
     return;
   }
 
-  // cap the number of lanes at the number of cars
-  if (lanes > cars) {
-    lanes = cars;
+  // all cars must be created before generating the race schedules
+  // take this opportunity to reset the results as well
+  tournament = Tournament();
+  for (int i = 0; i < division_cars.size(); i++) {
+    tournament.AddDivision(std::to_string(i + 1), division_cars[i], lanes,
+                           rounds);
   }
+  tournament.GenerateSchedules();
 
-  auto schedule_summary{std::stringstream()};
+  UpdateScheduleText();
+  analytics_stale = true;
 
-  // all cars must be created before generating the race schedule
-  // take this opportunity to reset the results as well
-  roster = std::vector<Car>();
-  results = std::vector<std::vector<std::unique_ptr<Result>>>();
-  for (int i = 0; i < cars; i++) {
-    roster.emplace_back(i + 1);
-    results.emplace_back(std::vector<std::unique_ptr<Result>>());
+  auto heats{0};
+  for (const auto &division : tournament.Divisions()) {
+    heats += division->heat_count;
   }
+  timeline.Reset(heats);
 
-  auto initial_schedule{std::vector<std::vector<const Car *>>()};
-  if (lanes == 4 && cars <= 13) {
-    // use pre-generated races for 4 lane tracks up to 13 racers
-    initial_schedule = LoadPreGeneratedSchedule(roster);
-  } else {
-    // generate the race schedule
-    for (int i = 0; i < cars; i++) {
-      auto heat{std::vector<const Car *>()};
-      for (int lane = 0; lane < lanes; lane++) {
-        heat.emplace_back(&roster[(i + lane) % cars]);
-      }
-      initial_schedule.emplace_back(heat);
-    }
+  IncrementCounter(Counter::kSchedulesGenerated);
+  if (!race_in_progress) {
+    race_in_progress = true;
+    AdjustGauge(Gauge::kActiveRaces, 1);
   }
 
-  // try to arrange the schedule so that cars are not in adjacent heats
-  schedule = std::vector<std::vector<const Car *>>();
+  // drop lineups of any earlier schedule, then show the first heat
+  ResetLineups();
+  StartDivision(0);
 
-  // move the first heat into the optimized_schedule
-  schedule.emplace_back(initial_schedule[0]);
-  initial_schedule.erase(initial_schedule.begin());
+  // enable run, standings and analytics tabs, then move to run_tab
+  run_tab->enable();
+  standings_tab->enable();
+  analytics_tab->enable();
+  run_tab->select();
 
-  // populate the optimized_schedule, preferring arrangements where the
-  // cars are not in adjacent heats
-  for (int i = 1; i < cars; i++) {
-    int next_heat{0};
+  // once generated, page should be reloaded to change the number of lanes
+  // to start from a clean slate
+  number_of_lanes->disable();
+}
 
-    // look for a better next heat, if possible by comparing with the
-    // previous heat in the optimized schedule
-    for (int proposed_idx = 0; proposed_idx < initial_schedule.size();
-         proposed_idx++) {
-      if (!DoAnyCarsMatch(schedule[i - 1], initial_schedule[proposed_idx])) {
-        next_heat = proposed_idx;
-        break;
+void RacingWebApplication::UpdateScheduleText() {
+  auto schedule_summary{std::stringstream()};
+
+  // display the schedules
+  for (const auto &division : tournament.Divisions()) {
+    if (tournament.Divisions().size() > 1) {
+      schedule_summary << "<b>" << DivisionTitle(*division) << "</b><br />";
+    }
+    for (int i = 0; i < division->schedule.size(); i++) {
+      // accepted multi-round heats no longer have a lineup
+      if (division->schedule[i].empty()) {
+        continue;
+      }
+      schedule_summary << "Heat " << i + 1 << ": ";
+      for (const auto &car : division->schedule[i]) {
+        schedule_summary << car->number << " ";
       }
+      schedule_summary << "<br />";
     }
 
-    // move the next heat into the optimized schedule
-    schedule.emplace_back(initial_schedule[next_heat]);
-    initial_schedule.erase(initial_schedule.begin() + next_heat);
-  }
-
-  // display the standings
-  for (int i = 0; i < cars; i++) {
-    schedule_summary << "Heat " << i + 1 << ": ";
-    for (int lane = 0; lane < lanes; lane++) {
-      schedule_summary << schedule[i][lane]->number << " ";
+    // multi-round heats are only generated as racing reaches them
+    auto pending =
+        division->heat_count - static_cast<int>(division->schedule.size());
+    if (pending > 0) {
+      schedule_summary << pending
+                       << " more heats will be generated as racing advances"
+                       << "<br />";
     }
-    schedule_summary << "<br />";
   }
   schedule_text->setText(schedule_summary.str());
+}
+
+void RacingWebApplication::StartDivision(const int division) {
+  current_division = division;
+
+  // heats of every earlier division come first on the event timeline
+  timeline_offset = 0;
+  for (int i = 0; i < division; i++) {
+    timeline_offset += tournament.Divisions()[i]->heat_count;
+  }
 
-  // update the current heat and enable run and standings tabs
   SetCurrentHeat(0);
+}
 
-  // move to run_tab
-  run_tab->enable();
-  standings_tab->enable();
-  run_tab->select();
+Division &RacingWebApplication::CurrentDivision() const {
+  return *tournament.Divisions()[current_division];
+}
 
-  // once generated, page should be reloaded to change the number of lanes
-  // to start from a clean slate
-  number_of_lanes->disable();
+std::string RacingWebApplication::DivisionTitle(
+    const Division &division) const {
+  if (tournament.Divisions().size() == 1) {
+    return "";
+  }
+  return division.finals ? "Finals" : "Division " + division.name;
+}
+
+std::string RacingWebApplication::ButtonName(const int division,
+                                             const int heat,
+                                             const std::string &button) {
+  return "d" + std::to_string(division) + "-h" + std::to_string(heat) + "-" +
+         button;
 }
 
 void RacingWebApplication::SetCurrentHeat(int heat) {
+  RACINGWEB_TRACE_SCOPE("SetCurrentHeat");
+  const auto &schedule = CurrentDivision().schedule;
+
+  // generate the heat and the one on deck if they do not exist yet
+  MaterializeHeats(CurrentDivision(), heat + kHeatLookahead);
+
+  // multi-round heats come and go as racing advances, so keep the setup
+  // tab's listing of them current
+  if (CurrentDivision().heat_stream) {
+    UpdateScheduleText();
+  }
+
   // if the heat value is negative or exceeds size, then we must be done
   // racing.  update the UI to indicate that.
   if (heat < 0 || heat > schedule.size()) {
@@ -131,13 +193,27 @@ void RacingWebApplication::SetCurrentHeat(int heat) {
     return;
   }
   current_heat = heat;
+  timeline.HeatStarted(timeline_offset + current_heat);
+
+  // set title for run tab, naming the division when there is more than one
+  auto title = DivisionTitle(CurrentDivision());
+  run_title->setText((title.empty() ? "" : title + ": ") + "Heat " +
+                     std::to_string(current_heat + 1) + " of " +
+                     std::to_string(CurrentDivision().heat_count));
+
+  // swap in the lineup prepared while the last heat ran, or build it now
+  auto standby = 1 - active_lineup;
+  if (lineup_buffers[standby].division == current_division &&
+      lineup_buffers[standby].heat == current_heat) {
+    active_lineup = standby;
+    lineup_stack->setCurrentIndex(active_lineup);
+  } else {
+    UpdateLineupContainer();
+  }
 
-  // set title for run tab
-  run_title->setText("Heat " + std::to_string(current_heat + 1) + " of " +
-                     std::to_string(schedule.size()));
-
-  // update layouts on run tab
-  UpdateLineupContainer();
+  // build the on-deck lineup in a request of its own, once this one is done
+  Wt::WTimer::singleShot(std::chrono::milliseconds(0), this,
+                         &RacingWebApplication::PrepareOnDeckLineup);
 
   // update preview of next heat
   auto on_deck{IdentifyHeatOnDeck()};
@@ -151,12 +227,95 @@ void RacingWebApplication::SetCurrentHeat(int heat) {
       preview_builder << schedule[on_deck][i]->number;
     }
     heat_preview_text->setText(preview_builder.str());
+  } else if (current_division + 1 < tournament.Divisions().size()) {
+    // the next division starts right after this one
+    const auto &next_division = *tournament.Divisions()[current_division + 1];
+    auto preview_builder = std::stringstream();
+    preview_builder << "On Deck - " << DivisionTitle(next_division)
+                    << " Heat 1: ";
+    for (int i = 0; i < next_division.schedule[0].size(); i++) {
+      if (i != 0) {
+        preview_builder << ", ";
+      }
+      preview_builder << next_division.schedule[0][i]->number;
+    }
+    heat_preview_text->setText(preview_builder.str());
   } else {
     heat_preview_text->setText("No more heats to run");
   }
+
+  UpdatePaceText();
+}
+
+void RacingWebApplication::AcceptResults() {
+  RACINGWEB_TRACE_SCOPE("AcceptResults");
+
+  // a heat is only accepted once every lane has a place
+  const auto &heat_results = CurrentDivision().results[current_heat];
+  if (heat_results.empty() ||
+      !std::all_of(heat_results.begin(), heat_results.end(),
+                   [](const auto &result) { return result.has_value(); })) {
+    return;
+  }
+
+  auto latency = ScopedLatency(Histogram::kAcceptResults);
+  IncrementCounter(Counter::kHeatsCompleted);
+  timeline.HeatAccepted(timeline_offset + current_heat);
+
+  // fold the heat into the running lane and head-to-head statistics; the
+  // analytics tab picks them up the next time it is opened
+  CurrentDivision().analytics.RecordHeat(
+      CurrentDivision().roster, CurrentDivision().results[current_heat]);
+  RetireHeat(CurrentDivision(), current_heat);
+  analytics_stale = true;
+
+  // move on to the next division once this one is done
+  auto next_heat = IdentifyNextHeat();
+  if (next_heat < 0 && current_division + 1 < tournament.Divisions().size()) {
+    StartDivision(current_division + 1);
+    return;
+  }
+  SetCurrentHeat(next_heat);
+}
+
+void RacingWebApplication::UpdatePaceText() {
+  if (timeline.HeatsAccepted() == 0) {
+    pace_text->setText("Pace: waiting for the first heat");
+    return;
+  }
+
+  auto pace_builder = std::stringstream();
+  pace_builder << std::fixed << std::setprecision(1);
+
+  // once every heat is in, summarize the whole race instead
+  auto heats_remaining{0};
+  for (const auto &division : tournament.Divisions()) {
+    heats_remaining +=
+        static_cast<int>(std::count_if(
+            division->results.begin(), division->results.end(),
+            [](const auto &heat) { return heat.empty(); })) +
+        division->heat_count - static_cast<int>(division->schedule.size());
+  }
+  if (heats_remaining == 0) {
+    pace_builder << "Raced " << timeline.HeatsAccepted() << " heats in "
+                 << FormatDuration(timeline.Elapsed())
+                 << ", average wait to accept "
+                 << FormatDuration(timeline.AverageDwell());
+    pace_text->setText(pace_builder.str());
+    return;
+  }
+
+  auto remaining = timeline.Remaining(heats_remaining);
+  pace_builder << "Pace: " << timeline.HeatsPerHour() << " heats/hour, "
+               << "last wait to accept " << FormatDuration(timeline.LastDwell())
+               << " (average " << FormatDuration(timeline.AverageDwell())
+               << "), projected finish " << FormatClockTimeFromNow(remaining)
+               << " (" << FormatDuration(remaining) << " remaining)";
+  pace_text->setText(pace_builder.str());
 }
 
 int RacingWebApplication::IdentifyNextHeat() const {
+  const auto &results = CurrentDivision().results;
   for (int i = 0; i < results.size(); i++) {
     if (results[i].empty()) {
       return i;
@@ -166,6 +325,7 @@ int RacingWebApplication::IdentifyNextHeat() const {
 }
 
 int RacingWebApplication::IdentifyHeatOnDeck() const {
+  const auto &results = CurrentDivision().results;
   auto found_first{false};
   for (int i = 0; i < results.size(); i++) {
     if (results[i].empty()) {
@@ -180,73 +340,98 @@ int RacingWebApplication::IdentifyHeatOnDeck() const {
 }
 
 void RacingWebApplication::UpdateLineupContainer() {
-  auto lanes = static_cast<int>(schedule[current_heat].size() & INT_MAX);
+  BuildLineup(lineup_buffers[active_lineup], current_division, current_heat);
+}
 
-  lineup_container->clear();
+void RacingWebApplication::BuildLineup(LineupBuffer &buffer,
+                                       const int division, const int heat) {
+  RACINGWEB_TRACE_SCOPE("BuildLineup");
+  const auto &schedule = tournament.Divisions()[division]->schedule;
+  auto lanes = static_cast<int>(schedule[heat].size() & INT_MAX);
+
+  buffer.container->clear();
+  buffer.division = division;
+  buffer.heat = heat;
 
   // lay out the lineup in a grid
   auto lineup_grid_layout =
-      lineup_container->setLayout(std::make_unique<Wt::WGridLayout>());
+      buffer.container->setLayout(std::make_unique<Wt::WGridLayout>());
 
   // set the last column to take up all excess space
   lineup_grid_layout->setColumnStretch(0, 0);  // lane
   lineup_grid_layout->setColumnStretch(1, 0);  // car number
   lineup_grid_layout->setColumnStretch(2, 0);  // car name
   lineup_grid_layout->setColumnStretch(3, 0);  // driver name
-  for (int i = 0; i < schedule[current_heat].size(); i++) {
+  for (int i = 0; i < schedule[heat].size(); i++) {
     lineup_grid_layout->setColumnStretch(i + 4, 0);  // places
   }
   lineup_grid_layout->setColumnStretch(lanes + 4, 100);
 
   // read the schedule data and fill in the grid layout
+  auto &place_button_matrix = buffer.place_button_matrix;
   place_button_matrix = std::vector<std::vector<Wt::WPushButton *>>();
   auto show_car_name{false}, show_driver_name{false};
-  for (int i = 0; i < schedule[current_heat].size(); i++) {
+  for (int i = 0; i < schedule[heat].size(); i++) {
     lineup_grid_layout->addWidget(
         std::make_unique<Wt::WText>(std::to_string(i + 1)), i + 1, 0);
     lineup_grid_layout->addWidget(
-        std::make_unique<Wt::WText>(schedule[current_heat][i]->number), i + 1,
-        1);
+        std::make_unique<Wt::WText>(schedule[heat][i]->number), i + 1, 1);
 
-    if (!schedule[current_heat][i]->car.empty()) {
+    if (!schedule[heat][i]->car.empty()) {
       show_car_name = true;
       lineup_grid_layout->addWidget(
-          std::make_unique<Wt::WText>(schedule[current_heat][i]->car), i + 1,
-          2);
+          std::make_unique<Wt::WText>(schedule[heat][i]->car), i + 1, 2);
     }
 
-    if (!schedule[current_heat][i]->car.empty()) {
+    if (!schedule[heat][i]->car.empty()) {
       show_driver_name = true;
       lineup_grid_layout->addWidget(
-          std::make_unique<Wt::WText>(schedule[current_heat][i]->driver), i + 1,
-          3);
+          std::make_unique<Wt::WText>(schedule[heat][i]->driver), i + 1, 3);
     }
 
     // buttons to indicate places
     place_button_matrix.emplace_back(std::vector<Wt::WPushButton *>());
-    for (int place = 0; place < schedule[current_heat].size(); place++) {
+    for (int place = 0; place < schedule[heat].size(); place++) {
       place_button_matrix[i].emplace_back(lineup_grid_layout->addWidget(
           std::make_unique<Wt::WPushButton>(std::to_string(place + 1)), i + 1,
           place + 4));
 
-      place_button_matrix[i][place]->clicked().connect([this, i, place]() {
-        MarkPlace(*schedule[current_heat][i], i, place);
-      });
+      place_button_matrix[i][place]->setObjectName(
+          ButtonName(division, heat, "l" + std::to_string(i) + "-p" +
+                                         std::to_string(place)));
+
+      // a grid that was swapped out may still deliver a queued click
+      place_button_matrix[i][place]->clicked().connect(
+          [this, division, heat, i, place]() {
+            if (division != current_division || heat != current_heat) {
+              return;
+            }
+            MarkPlace(*CurrentDivision().schedule[heat][i], i, place);
+          });
     }
   }
 
-  accept_results_button = lineup_grid_layout->addWidget(
+  buffer.accept_results_button = lineup_grid_layout->addWidget(
       std::make_unique<Wt::WPushButton>("Accept Results"), lanes + 1, 4, 1,
       lanes);
-  accept_results_button->disable();
-  accept_results_button->clicked().connect(
-      [this]() { SetCurrentHeat(IdentifyNextHeat()); });
+  buffer.accept_results_button->setObjectName(
+      ButtonName(division, heat, "accept"));
+  buffer.accept_results_button->disable();
+  buffer.accept_results_button->clicked().connect([this, division, heat]() {
+    if (division != current_division || heat != current_heat) {
+      return;
+    }
+    AcceptResults();
+  });
 
   auto reset_results_button = lineup_grid_layout->addWidget(
       std::make_unique<Wt::WPushButton>("Clear Results"), lanes + 2, 4, 1,
       lanes);
-  reset_results_button->clicked().connect([this]() {
-    results[current_heat] = std::vector<std::unique_ptr<Result>>();
+  reset_results_button->clicked().connect([this, division, heat]() {
+    if (division != current_division || heat != current_heat) {
+      return;
+    }
+    CurrentDivision().results[heat].clear();
     UpdateLineupContainer();
   });
 
@@ -266,25 +451,63 @@ void RacingWebApplication::UpdateLineupContainer() {
   lineup_grid_layout->addWidget(std::make_unique<Wt::WText>(), 0, 4 + lanes);
 }
 
+void RacingWebApplication::PrepareOnDeckLineup() {
+  RACINGWEB_TRACE_SCOPE("PrepareOnDeckLineup");
+  if (!race_in_progress) {
+    return;
+  }
+
+  // the on-deck heat may be the first heat of the next division
+  auto division{current_division}, heat{IdentifyHeatOnDeck()};
+  if (heat < 0) {
+    if (current_division + 1 >= tournament.Divisions().size()) {
+      return;
+    }
+    division = current_division + 1;
+    heat = 0;
+  }
+
+  auto &standby = lineup_buffers[1 - active_lineup];
+  if (standby.division != division || standby.heat != heat) {
+    BuildLineup(standby, division, heat);
+  }
+}
+
+void RacingWebApplication::ResetLineups() {
+  for (auto &buffer : lineup_buffers) {
+    buffer.container->clear();
+    buffer.division = -1;
+    buffer.heat = -1;
+    buffer.place_button_matrix.clear();
+    buffer.accept_results_button = nullptr;
+  }
+}
+
 void RacingWebApplication::MarkPlace(const Car &car, const int lane,
                                      const int place) {
+  RACINGWEB_TRACE_SCOPE("MarkPlace");
+  auto latency = ScopedLatency(Histogram::kMarkPlace);
+  const auto &schedule = CurrentDivision().schedule;
+  auto &results = CurrentDivision().results;
+  auto &buffer = lineup_buffers[active_lineup];
+
   // if this is the first record in this heat, create the array
   if (results[current_heat].empty()) {
-    results[current_heat] =
-        std::vector<std::unique_ptr<Result>>(schedule[current_heat].size());
+    results[current_heat].resize(schedule[current_heat].size());
   }
 
   // place the heat
-  results[current_heat][lane] = std::make_unique<Result>(car, place);
+  results[current_heat][lane].emplace(car, place);
+  timeline.ResultEntered(timeline_offset + current_heat);
 
   // disable no longer relevant buttons
   for (int i = 0; i < schedule[current_heat].size(); i++) {
-    place_button_matrix[lane][i]->disable();
-    place_button_matrix[lane][i]->setText("x");
-    place_button_matrix[i][place]->disable();
-    place_button_matrix[i][place]->setText("x");
+    buffer.place_button_matrix[lane][i]->disable();
+    buffer.place_button_matrix[lane][i]->setText("x");
+    buffer.place_button_matrix[i][place]->disable();
+    buffer.place_button_matrix[i][place]->setText("x");
   }
-  place_button_matrix[lane][place]->setText("O");
+  buffer.place_button_matrix[lane][place]->setText("O");
 
   // check if all results are now in
   auto any_results_open = false;
@@ -295,24 +518,53 @@ void RacingWebApplication::MarkPlace(const Car &car, const int lane,
     }
   }
   if (!any_results_open) {
-    accept_results_button->enable();
+    buffer.accept_results_button->enable();
   }
 }
 void RacingWebApplication::FinishRacing() {
+  RACINGWEB_TRACE_SCOPE("FinishRacing");
+  if (race_in_progress) {
+    race_in_progress = false;
+    AdjustGauge(Gauge::kActiveRaces, -1);
+  }
+
   run_title->setText("Finished");
-  lineup_container->clear();
-  lineup_container->addWidget(std::make_unique<Wt::WText>("Done racing!"));
+  ResetLineups();
+  lineup_buffers[active_lineup].container->addWidget(
+      std::make_unique<Wt::WText>("Done racing!"));
+  UpdatePaceText();
 
   UpdateStandingsContainer();
   standings_tab->select();
 }
 
 void RacingWebApplication::UpdateStandingsContainer() {
+  RACINGWEB_TRACE_SCOPE("UpdateStandingsContainer");
   standings_container->clear();
 
+  // one standings grid per division, titled when there is more than one
+  for (const auto &division : tournament.Divisions()) {
+    auto title = DivisionTitle(*division);
+    if (!title.empty()) {
+      standings_container->addWidget(std::make_unique<Wt::WText>(title))
+          ->setHtmlTagName("h2");
+    }
+    standings_container->addWidget(BuildDivisionStandings(*division));
+  }
+
+  // finals can be seeded once every preliminary division has been raced
+  finals_container->setHidden(tournament.Divisions().size() < 2 ||
+                              tournament.HasFinals() ||
+                              !tournament.IsFinished());
+}
+
+std::unique_ptr<Wt::WContainerWidget>
+RacingWebApplication::BuildDivisionStandings(const Division &division) {
+  auto container = std::make_unique<Wt::WContainerWidget>();
+
   // lay out the standings in a grid
   auto standings_grid_layout =
-      standings_container->setLayout(std::make_unique<Wt::WGridLayout>());
+      container->setLayout(std::make_unique<Wt::WGridLayout>());
 
   // set the last column to take up all excess space
   standings_grid_layout->setColumnStretch(0, 0);  // place
@@ -321,7 +573,7 @@ void RacingWebApplication::UpdateStandingsContainer() {
   standings_grid_layout->setColumnStretch(3, 0);  // driver name
   standings_grid_layout->setColumnStretch(4, 100);
 
-  auto final_standings = CalculateFinalStandings();
+  auto final_standings = CalculateStandings(division.roster, division.results);
 
   // read the schedule data and fill in the grid layout
   auto show_car_name{false}, show_driver_name{false};
@@ -354,29 +606,160 @@ void RacingWebApplication::UpdateStandingsContainer() {
   }
   // add blank text so last column will stretch
   standings_grid_layout->addWidget(std::make_unique<Wt::WText>(), 0, 4);
+
+  return container;
 }
-std::vector<const Car *> RacingWebApplication::CalculateFinalStandings() {
-  auto final_standings = std::vector<const Car *>();
-  for (const auto &item : roster) {
-    final_standings.emplace_back(&item);
+
+void RacingWebApplication::SeedFinals() {
+  int finalists;
+
+  // failure to parse is likely the result of an accidental button click
+  // just ignore it
+  try {
+    finalists = std::stoi(finalists_per_division->text());
+  } catch (std::invalid_argument const &invalid_argument) {
+    return;
+  } catch (std::out_of_range const &out_of_range) {
+    return;
   }
 
-  // create map to store score calculations in
-  auto scores = std::map<const Car *, int>();
-  std::for_each(roster.begin(), roster.end(),
-                [&scores](const auto &x) { scores[&x] = 0; });
+  if (finalists < 1 || tournament.Divisions().size() < 2 ||
+      tournament.HasFinals() || !tournament.IsFinished()) {
+    return;
+  }
 
-  // add up the results
-  for (const auto &heat : results) {
-    std::for_each(heat.begin(), heat.end(),
-                  [&scores](const auto &x) { scores[x->car] += x->place; });
+  // the finals race on the same track and rounds as the preliminaries
+  auto &finals = tournament.SeedFinals(finalists,
+                                       tournament.Divisions()[0]->lanes,
+                                       tournament.Divisions()[0]->rounds);
+  timeline.Extend(finals.heat_count);
+  UpdateScheduleText();
+  analytics_stale = true;
+
+  if (!race_in_progress) {
+    race_in_progress = true;
+    AdjustGauge(Gauge::kActiveRaces, 1);
   }
 
-  // final standings sort
-  std::sort(final_standings.begin(), final_standings.end(),
-            [&scores](const auto &a, const auto &b) {
-              return scores[a] < scores[b];
-            });
+  finals_container->hide();
+  ResetLineups();
+  StartDivision(static_cast<int>(tournament.Divisions().size()) - 1);
+  run_tab->select();
+}
 
-  return std::move(final_standings);
+void RacingWebApplication::UpdateAnalyticsContainer() {
+  RACINGWEB_TRACE_SCOPE("UpdateAnalyticsContainer");
+  analytics_stale = false;
+  analytics_container->clear();
+
+  // the track is shared, so lane totals are combined across divisions
+  auto lanes{std::vector<LaneStats>()};
+  for (const auto &division : tournament.Divisions()) {
+    const auto &division_lanes = division->analytics.Lanes();
+    if (lanes.size() < division_lanes.size()) {
+      lanes.resize(division_lanes.size());
+    }
+    for (int lane = 0; lane < division_lanes.size(); lane++) {
+      lanes[lane].Merge(division_lanes[lane]);
+    }
+  }
+
+  analytics_container->addWidget(std::make_unique<Wt::WText>("Lanes"))
+      ->setHtmlTagName("h2");
+  auto lanes_grid_layout =
+      analytics_container
+          ->addWidget(std::make_unique<Wt::WContainerWidget>())
+          ->setLayout(std::make_unique<Wt::WGridLayout>());
+
+  // set the last column to take up all excess space
+  for (int column = 0; column < 6; column++) {
+    lanes_grid_layout->setColumnStretch(column, 0);
+  }
+  lanes_grid_layout->setColumnStretch(6, 100);
+
+  lanes_grid_layout->addWidget(std::make_unique<Wt::WText>("Lane"), 0, 0);
+  lanes_grid_layout->addWidget(std::make_unique<Wt::WText>("Races"), 0, 1);
+  lanes_grid_layout->addWidget(std::make_unique<Wt::WText>("Wins"), 0, 2);
+  lanes_grid_layout->addWidget(
+      std::make_unique<Wt::WText>("Win rate (95% CI)"), 0, 3);
+  lanes_grid_layout->addWidget(
+      std::make_unique<Wt::WText>("Average place (95% CI)"), 0, 4);
+  lanes_grid_layout->addWidget(std::make_unique<Wt::WText>(), 0, 6);
+
+  for (int lane = 0; lane < lanes.size(); lane++) {
+    double low, high;
+    lanes[lane].WinRateInterval(low, high);
+
+    auto win_rate = std::stringstream();
+    win_rate << std::fixed << std::setprecision(0)
+             << lanes[lane].WinRate() * 100 << "% (" << low * 100 << "-"
+             << high * 100 << "%)";
+    auto average_place = std::stringstream();
+    average_place << std::fixed << std::setprecision(2)
+                  << lanes[lane].AveragePlace() << " +/- "
+                  << lanes[lane].AveragePlaceMargin();
+
+    lanes_grid_layout->addWidget(
+        std::make_unique<Wt::WText>(std::to_string(lane + 1)), lane + 1, 0);
+    lanes_grid_layout->addWidget(
+        std::make_unique<Wt::WText>(std::to_string(lanes[lane].races)),
+        lane + 1, 1);
+    lanes_grid_layout->addWidget(
+        std::make_unique<Wt::WText>(std::to_string(lanes[lane].wins)),
+        lane + 1, 2);
+    lanes_grid_layout->addWidget(std::make_unique<Wt::WText>(win_rate.str()),
+                                 lane + 1, 3);
+    lanes_grid_layout->addWidget(
+        std::make_unique<Wt::WText>(average_place.str()), lane + 1, 4);
+    if (lanes[lane].IsBiased(static_cast<int>(lanes.size()))) {
+      lanes_grid_layout->addWidget(
+          std::make_unique<Wt::WText>("<b>possible bias</b>"), lane + 1, 5);
+    }
+  }
+
+  // head-to-head grids are only readable for small divisions, larger ones
+  // are in the csv download
+  constexpr int kMaxHeadToHeadCars = 16;
+  for (const auto &division : tournament.Divisions()) {
+    const auto &analytics = division->analytics;
+    auto title = DivisionTitle(*division);
+    analytics_container
+        ->addWidget(std::make_unique<Wt::WText>(
+            "Head to head" + (title.empty() ? "" : " - " + title)))
+        ->setHtmlTagName("h2");
+    if (analytics.Cars() > kMaxHeadToHeadCars) {
+      analytics_container->addWidget(std::make_unique<Wt::WText>(
+          "Too many cars to show here, see the CSV download"));
+      continue;
+    }
+
+    auto rivalry_grid_layout =
+        analytics_container
+            ->addWidget(std::make_unique<Wt::WContainerWidget>())
+            ->setLayout(std::make_unique<Wt::WGridLayout>());
+
+    // rows are the car, columns the opponent, cells are wins-losses
+    for (int a = 0; a < analytics.Cars(); a++) {
+      rivalry_grid_layout->setColumnStretch(a + 1, 0);
+      rivalry_grid_layout->addWidget(
+          std::make_unique<Wt::WText>(division->roster[a].number), 0, a + 1);
+      rivalry_grid_layout->addWidget(
+          std::make_unique<Wt::WText>(division->roster[a].number), a + 1, 0);
+      for (int b = 0; b < analytics.Cars(); b++) {
+        if (a == b || analytics.Meetings(a, b) == 0) {
+          continue;
+        }
+        rivalry_grid_layout->addWidget(
+            std::make_unique<Wt::WText>(std::to_string(analytics.Wins(a, b)) +
+                                        "-" +
+                                        std::to_string(analytics.Wins(b, a))),
+            a + 1, b + 1);
+      }
+    }
+
+    // add blank text so last column will stretch
+    rivalry_grid_layout->setColumnStretch(analytics.Cars() + 1, 100);
+    rivalry_grid_layout->addWidget(std::make_unique<Wt::WText>(), 0,
+                                   analytics.Cars() + 1);
+  }
 }
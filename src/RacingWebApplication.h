@@ -6,20 +6,26 @@
 #ifndef RACINGWEB_SRC_RACINGWEBAPPLICATION_H_
 #define RACINGWEB_SRC_RACINGWEBAPPLICATION_H_
 
+#include <Wt/WAnchor.h>
 #include <Wt/WApplication.h>
 #include <Wt/WContainerWidget.h>
 #include <Wt/WGridLayout.h>
 #include <Wt/WHBoxLayout.h>
 #include <Wt/WLineEdit.h>
+#include <Wt/WLink.h>
 #include <Wt/WMenuItem.h>
 #include <Wt/WPanel.h>
 #include <Wt/WPushButton.h>
+#include <Wt/WStackedWidget.h>
 #include <Wt/WTabWidget.h>
 #include <Wt/WText.h>
+#include <Wt/WTimer.h>
 #include <Wt/WVBoxLayout.h>
 
 #include <algorithm>
+#include <array>
 #include <climits>
+#include <iomanip>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -27,10 +33,14 @@
 #include <utility>
 #include <vector>
 
+#include "src/AnalyticsResource.h"
 #include "src/Car.h"
+#include "src/EventTimeline.h"
 #include "src/Result.h"
-#include "src/pregen.h"
+#include "src/Tournament.h"
+#include "src/metrics.h"
 #include "src/raceutil.h"
+#include "src/trace.h"
 
 /**
  * @brief application state container class
@@ -43,7 +53,29 @@ class RacingWebApplication : public Wt::WApplication {
    */
   explicit RacingWebApplication(const Wt::WEnvironment &env);
 
+  /**
+   * @brief closes the session and releases its metrics
+   */
+  ~RacingWebApplication() override;
+
  private:
+  /// @brief the headless benchmark drives the ui handlers directly
+  friend class SessionBench;
+
+  /// @brief one of the two lineup grids on the run tab
+  struct LineupBuffer {
+    /// @brief the grid container, a page of lineup_stack
+    Wt::WContainerWidget *container = nullptr;
+    /// @brief division of the heat in the grid, or -1 if none
+    int division = -1;
+    /// @brief heat in the grid, or -1 if none
+    int heat = -1;
+    /// @brief matrix of buttons that indicate finish line places
+    std::vector<std::vector<Wt::WPushButton *>> place_button_matrix;
+    /// @brief accept final results
+    Wt::WPushButton *accept_results_button = nullptr;
+  };
+
   /**
    * @brief builds the setup container and saves key elements as members
    * @return unique pointer to setup container
@@ -62,35 +94,121 @@ class RacingWebApplication : public Wt::WApplication {
    */
   std::unique_ptr<Wt::WContainerWidget> BuildStandingsContainer();
 
+  /**
+   * @brief builds the analytics container and saves key elements as members
+   * @return unique pointer to analytics container
+   */
+  std::unique_ptr<Wt::WContainerWidget> BuildAnalyticsContainer();
+
+  /**
+   * @brief read the lane and head-to-head statistics and update the tab
+   *
+   * Only called when the analytics tab is selected while analytics_stale is
+   * set, so accepting a heat does not rebuild a tab nobody is looking at.
+   */
+  void UpdateAnalyticsContainer();
+
   /**
    * @brief read the current_heat and update the lineup for the race tab
    */
   void UpdateLineupContainer();
 
   /**
-   * @brief read results and return an ordered vector of winners
+   * @brief fill a lineup grid with a heat from the schedule
+   * @param buffer the grid to rebuild
+   * @param division which division the heat belongs to
+   * @param heat which heat of the division to show
+   */
+  void BuildLineup(LineupBuffer &buffer, int division, int heat);
+
+  /**
+   * @brief build the on-deck heat into the hidden lineup grid
    *
-   * the car in index 0 came in first place, index 1 is second place, and so on
-   * @return the ordered list of winners
+   * Runs from a timer after the current heat is shown, so the widgets reach
+   * the browser while the heat is racing and accepting it is only a swap.
+   */
+  void PrepareOnDeckLineup();
+
+  /**
+   * @brief forget both lineup grids, e.g. when the schedule is replaced
    */
-  std::vector<const Car *> CalculateFinalStandings();
+  void ResetLineups();
 
   /**
    * @brief read the results and update the standings tab
    */
   void UpdateStandingsContainer();
 
+  /**
+   * @brief builds the standings grid for one division
+   * @param division the division to show
+   * @return unique pointer to the standings grid container
+   */
+  std::unique_ptr<Wt::WContainerWidget> BuildDivisionStandings(
+      const Division &division);
+
   /**
    * @brief generates the schedule
    *
-   * This method generates schedules where number_of_cars and number_of_lanes
-   * can have their text contents cast to and integer and
-   * 0 < number_of_cars and 0 < number_of_lanes <= number_of_cars.
-   * number_of_lanes will be capped to number_of_cars.  The roster and results
-   * data members are populated, and a schedule is created.
+   * This method generates schedules where number_of_cars is a comma separated
+   * list of car counts, one per division, and number_of_lanes and
+   * number_of_rounds can have their text contents cast to an integer and
+   * 0 < cars, 0 < number_of_lanes and 0 < number_of_rounds.
+   * number_of_lanes will be capped to the cars in each division.  The
+   * tournament is rebuilt and every division's schedule is generated in one
+   * batch, then the first division is started.
    */
   void GenerateSchedule();
 
+  /**
+   * @brief show every division's schedule on the setup tab
+   *
+   * Multi-round divisions only list the heats that are generated and not yet
+   * accepted, so this is called again as each of their heats starts.
+   */
+  void UpdateScheduleText();
+
+  /**
+   * @brief make a division current and show its first heat
+   * @param division index into the tournament's divisions
+   */
+  void StartDivision(int division);
+
+  /**
+   * @brief seed and start the finals from the preliminary standings
+   *
+   * Takes no action unless there are at least two preliminary divisions and
+   * every heat of them has been accepted.
+   */
+  void SeedFinals();
+
+  /**
+   * @brief the division shown on the run tab
+   * @return the current division
+   */
+  [[nodiscard]] Division &CurrentDivision() const;
+
+  /**
+   * @brief name a division for titles
+   * @param division the division to name
+   * @return "" when there is only one division, otherwise its title
+   */
+  [[nodiscard]] std::string DivisionTitle(const Division &division) const;
+
+  /**
+   * @brief object name of a lineup button, used by scripted clients
+   *
+   * Names carry the division and heat so the on-deck grid's buttons never
+   * share a name with the showing grid's.
+   *
+   * @param division which division the heat belongs to
+   * @param heat which heat of the division the button is in
+   * @param button "l<lane>-p<place>" for a place button or "accept"
+   * @return the name, e.g. "d0-h3-l1-p2"
+   */
+  [[nodiscard]] static std::string ButtonName(int division, int heat,
+                                              const std::string &button);
+
   /**
    * @brief sets current_heat and updates related text
    *
@@ -101,6 +219,18 @@ class RacingWebApplication : public Wt::WApplication {
    */
   void SetCurrentHeat(int heat);
 
+  /**
+   * @brief accept the results of the current heat and move to the next one
+   *
+   * Takes no action unless every lane of the current heat has a place.
+   */
+  void AcceptResults();
+
+  /**
+   * @brief show the heat rate, dwell times and projected finish on the run tab
+   */
+  void UpdatePaceText();
+
   /**
    * @brief update the ui to indicate the race is over
    *
@@ -134,6 +264,9 @@ class RacingWebApplication : public Wt::WApplication {
   /// @brief text box for number of lanes on the track
   Wt::WLineEdit *number_of_lanes;
 
+  /// @brief text box for how many times each car races in each lane
+  Wt::WLineEdit *number_of_rounds;
+
   /// @brief output text containing schedule_text summary
   Wt::WText *schedule_text;
 
@@ -149,41 +282,62 @@ class RacingWebApplication : public Wt::WApplication {
   /// @brief standings tab
   Wt::WMenuItem *standings_tab;
 
-  /// @brief the cars that will be raced
-  std::vector<Car> roster;
+  /// @brief analytics tab
+  Wt::WMenuItem *analytics_tab;
 
-  /// @brief the race schedule, with pointers to cars on the roster
-  std::vector<std::vector<const Car *>> schedule;
+  /// @brief every division being raced, each with its roster and schedule
+  Tournament tournament;
 
-  /**
-   * @brief the finish line results
-   *
-   * The correct number of heats are pre-created when the schedule is
-   * generated.  A heat with a result length of zero indicatees a heat which
-   * has not been run yet.
-   */
-  std::vector<std::vector<std::unique_ptr<Result>>> results;
+  /// @brief which division is on the run tab (0-indexed, to match tournament)
+  int current_division = 0;
 
   /// @brief what heat are we currently on (0-indexed, to match schedule)
   int current_heat = 0;
 
+  /// @brief heats in divisions before the current one, for the timeline
+  int timeline_offset = 0;
+
+  /// @brief true from schedule generation until racing is finished
+  bool race_in_progress = false;
+
+  /// @brief start, result and accept times of every heat
+  EventTimeline timeline;
+
   /// @brief the title of the run container
   Wt::WText *run_title;
 
-  /// @brief the grid container for the current heat lineup
-  Wt::WContainerWidget *lineup_container;
+  /// @brief shows the current heat lineup and hides the one on deck
+  Wt::WStackedWidget *lineup_stack;
+
+  /// @brief the current heat and on-deck lineup grids, swapped on accept
+  std::array<LineupBuffer, 2> lineup_buffers;
+
+  /// @brief which of lineup_buffers is showing
+  int active_lineup = 0;
 
   /// @brief the grid container for the current heat lineup
   Wt::WContainerWidget *standings_container;
 
+  /// @brief form for seeding finals, shown once the preliminaries are done
+  Wt::WContainerWidget *finals_container;
+
+  /// @brief text box for how many cars from each division race in the finals
+  Wt::WLineEdit *finalists_per_division;
+
+  /// @brief the container for lane and head-to-head statistics
+  Wt::WContainerWidget *analytics_container;
+
+  /// @brief csv export of the statistics on the analytics tab
+  std::shared_ptr<AnalyticsResource> analytics_resource;
+
+  /// @brief true when heats were accepted since the analytics tab was built
+  bool analytics_stale = true;
+
   /// @brief the output text previewing the lineup for the next heat
   Wt::WText *heat_preview_text;
 
-  /// @brief matrix of buttons that indicate finish line places
-  std::vector<std::vector<Wt::WPushButton *>> place_button_matrix;
-
-  /// @brief accept final results
-  Wt::WPushButton *accept_results_button;
+  /// @brief the output text showing the heat rate and projected finish
+  Wt::WText *pace_text;
 };
 
 #endif  // RACINGWEB_SRC_RACINGWEBAPPLICATION_H_
@@ -23,8 +23,10 @@ RacingWebApplication::BuildSetupContainer() {
   form_grid_layout->setColumnStretch(1, 0);
   form_grid_layout->setColumnStretch(2, 100);
 
-  form_grid_layout->addWidget(std::make_unique<Wt::WText>("How many cars?"), 0,
-                              0);
+  form_grid_layout->addWidget(
+      std::make_unique<Wt::WText>("How many cars? (comma separated for "
+                                  "several divisions)"),
+      0, 0);
   number_of_cars =
       form_grid_layout->addWidget(std::make_unique<Wt::WLineEdit>("12"), 0, 1);
   number_of_cars->setFocus();
@@ -35,12 +37,19 @@ RacingWebApplication::BuildSetupContainer() {
   number_of_lanes =
       form_grid_layout->addWidget(std::make_unique<Wt::WLineEdit>("4"), 1, 1);
 
+  form_grid_layout->addWidget(
+      std::make_unique<Wt::WText>("How many times in each lane?"), 2, 0);
+
+  number_of_rounds =
+      form_grid_layout->addWidget(std::make_unique<Wt::WLineEdit>("1"), 2, 1);
+
   auto button = form_grid_layout->addWidget(
-      std::make_unique<Wt::WPushButton>("Generate schedule"), 2, 1);
+      std::make_unique<Wt::WPushButton>("Generate schedule"), 3, 1);
+  button->setObjectName("generate");
   button->clicked().connect(this, &RacingWebApplication::GenerateSchedule);
 
   // empty widget at the end to let the third column stretch out
-  form_grid_layout->addWidget(std::make_unique<Wt::WText>(""), 2, 2);
+  form_grid_layout->addWidget(std::make_unique<Wt::WText>(""), 3, 2);
 
   schedule_text = vert_layout->addWidget(std::make_unique<Wt::WText>());
 
@@ -57,13 +66,22 @@ RacingWebApplication::BuildRunContainer() {
   run_title = vert_layout->addWidget(std::make_unique<Wt::WText>());
   run_title->setHtmlTagName("h1");
 
-  // lay out the lineup in a grid
-  lineup_container =
-      vert_layout->addWidget(std::make_unique<Wt::WContainerWidget>());
+  // two lineup grids, one showing the current heat and one hidden that the
+  // on-deck heat is built into ahead of time.  they are rendered even while
+  // hidden so the browser already has the next lineup when it is swapped in.
+  lineup_stack = vert_layout->addWidget(std::make_unique<Wt::WStackedWidget>());
+  for (auto &buffer : lineup_buffers) {
+    buffer.container =
+        lineup_stack->addWidget(std::make_unique<Wt::WContainerWidget>());
+    buffer.container->setLoadLaterWhenInvisible(false);
+  }
 
   // add sneak peek of the next heat lineup
   heat_preview_text = vert_layout->addWidget(std::make_unique<Wt::WText>(""));
 
+  // how fast the race is going and when it should be done
+  pace_text = vert_layout->addWidget(std::make_unique<Wt::WText>(""));
+
   return container;
 }
 
@@ -81,5 +99,51 @@ RacingWebApplication::BuildStandingsContainer() {
   standings_container =
       vert_layout->addWidget(std::make_unique<Wt::WContainerWidget>());
 
+  // form to seed finals from the divisions, hidden until they have raced
+  finals_container =
+      vert_layout->addWidget(std::make_unique<Wt::WContainerWidget>());
+  finals_container->hide();
+  auto finals_grid_layout =
+      finals_container->setLayout(std::make_unique<Wt::WGridLayout>());
+
+  // set the third column to take up all excess space
+  finals_grid_layout->setColumnStretch(0, 0);
+  finals_grid_layout->setColumnStretch(1, 0);
+  finals_grid_layout->setColumnStretch(2, 100);
+
+  finals_grid_layout->addWidget(
+      std::make_unique<Wt::WText>("Finalists per division?"), 0, 0);
+  finalists_per_division =
+      finals_grid_layout->addWidget(std::make_unique<Wt::WLineEdit>("3"), 0, 1);
+
+  auto button = finals_grid_layout->addWidget(
+      std::make_unique<Wt::WPushButton>("Seed finals"), 1, 1);
+  button->clicked().connect(this, &RacingWebApplication::SeedFinals);
+
+  // empty widget at the end to let the third column stretch out
+  finals_grid_layout->addWidget(std::make_unique<Wt::WText>(""), 1, 2);
+
+  return container;
+}
+
+std::unique_ptr<Wt::WContainerWidget>
+RacingWebApplication::BuildAnalyticsContainer() {
+  auto container = std::make_unique<Wt::WContainerWidget>();
+  container->setPadding(Wt::WLength(10), Wt::AllSides);
+
+  // basic vertical layout
+  auto vert_layout = container->setLayout(std::make_unique<Wt::WVBoxLayout>());
+  vert_layout->addWidget(std::make_unique<Wt::WText>("Analytics"))
+      ->setHtmlTagName("h1");
+
+  // everything on this tab, and every rivalry, as a spreadsheet
+  analytics_resource = std::make_shared<AnalyticsResource>(tournament);
+  vert_layout->addWidget(std::make_unique<Wt::WAnchor>(
+      Wt::WLink(analytics_resource), "Download CSV"));
+
+  // lane and head-to-head grids
+  analytics_container =
+      vert_layout->addWidget(std::make_unique<Wt::WContainerWidget>());
+
   return container;
 }
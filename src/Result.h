@@ -6,6 +6,10 @@
 #ifndef RACINGWEB_SRC_RESULT_H_
 #define RACINGWEB_SRC_RESULT_H_
 
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
 #include "src/Car.h"
 
 /// @brief a single finish line result
@@ -25,4 +29,7 @@ struct Result {
   int place;
 };
 
+/// @brief the results of one heat by lane, empty until the heat is marked
+using HeatResults = std::pmr::vector<std::optional<Result>>;
+
 #endif  // RACINGWEB_SRC_RESULT_H_
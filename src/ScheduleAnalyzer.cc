@@ -0,0 +1,206 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/ScheduleAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+ScheduleAnalyzer::ScheduleAnalyzer(const std::vector<Car> &roster,
+                                   const RaceSchedule &schedule)
+    : cars(static_cast<int>(roster.size())),
+      heats(static_cast<int>(schedule.size())),
+      heat_words((cars + 63) / 64),
+      car_words((heats + 63) / 64) {
+  for (const auto &heat : schedule) {
+    lanes = std::max(lanes, static_cast<int>(heat.size()));
+  }
+
+  heat_cars = std::vector<std::vector<int>>(heats);
+  heat_bits = std::vector<uint64_t>(heats * heat_words);
+  car_bits = std::vector<uint64_t>(cars * car_words);
+  lane_coverage = std::vector<int>(cars * lanes);
+  for (int heat = 0; heat < heats; heat++) {
+    for (int lane = 0; lane < schedule[heat].size(); lane++) {
+      auto car = static_cast<int>(schedule[heat][lane] - roster.data());
+      heat_cars[heat].emplace_back(car);
+      lane_coverage[car * lanes + lane]++;
+
+      // a car listed twice in a heat still only races it once
+      if (!(heat_bits[heat * heat_words + car / 64] & 1ULL << car % 64)) {
+        ToggleMembership(car, heat);
+      }
+    }
+  }
+
+  // encounters are the popcount of two cars' heat bitsets ANDed together
+  encounters = std::vector<int>(cars * cars);
+  for (int a = 0; a < cars; a++) {
+    for (int b = a; b < cars; b++) {
+      auto shared{0};
+      for (int word = 0; word < car_words; word++) {
+        shared += __builtin_popcountll(car_bits[a * car_words + word] &
+                                       car_bits[b * car_words + word]);
+      }
+      encounters[a * cars + b] = shared;
+      encounters[b * cars + a] = shared;
+    }
+  }
+
+  for (int heat = 1; heat < heats; heat++) {
+    back_to_back += SharedCars(heat - 1, heat);
+  }
+
+  // average distance of each car's lane counts from an even split
+  auto lane_error{0.0};
+  auto expected = cars > 0 ? static_cast<double>(heats) / cars : 0.0;
+  for (const auto &count : lane_coverage) {
+    lane_error += std::abs(count - expected);
+  }
+  if (cars > 0) {
+    lane_error /= cars;
+  }
+
+  // spread of how often each pair of cars meets
+  auto pairs{0};
+  auto sum{0.0}, sum_squares{0.0};
+  for (int a = 0; a < cars; a++) {
+    for (int b = a + 1; b < cars; b++) {
+      sum += encounters[a * cars + b];
+      sum_squares += encounters[a * cars + b] * encounters[a * cars + b];
+      pairs++;
+    }
+  }
+  auto encounter_deviation{0.0};
+  if (pairs > 0) {
+    auto mean = sum / pairs;
+    encounter_deviation = std::sqrt(std::max(0.0, sum_squares / pairs -
+                                                      mean * mean));
+  }
+
+  order_independent_score = lane_error + encounter_deviation;
+}
+
+void ScheduleAnalyzer::SwapHeats(const int a, const int b) {
+  if (a == b) {
+    return;
+  }
+
+  back_to_back -= AdjacentSharedCars(a, b);
+
+  for (const auto &car : heat_cars[a]) {
+    ToggleMembership(car, a);
+    ToggleMembership(car, b);
+  }
+  for (const auto &car : heat_cars[b]) {
+    ToggleMembership(car, b);
+    ToggleMembership(car, a);
+  }
+  std::swap(heat_cars[a], heat_cars[b]);
+
+  back_to_back += AdjacentSharedCars(a, b);
+}
+
+std::vector<int> ScheduleAnalyzer::RestGaps() const {
+  auto gaps = std::vector<int>(std::max(heats, 1));
+  for (int car = 0; car < cars; car++) {
+    auto previous{-1};
+    for (int word = 0; word < car_words; word++) {
+      // walk the set bits, lowest heat first
+      for (auto bits = car_bits[car * car_words + word]; bits;
+           bits &= bits - 1) {
+        auto heat = word * 64 + __builtin_ctzll(bits);
+        if (previous >= 0) {
+          gaps[heat - previous - 1]++;
+        }
+        previous = heat;
+      }
+    }
+  }
+  return gaps;
+}
+
+double ScheduleAnalyzer::BalanceScore() const {
+  return order_independent_score +
+         (cars > 0 ? static_cast<double>(back_to_back) / cars : 0.0);
+}
+
+std::vector<std::string> ScheduleAnalyzer::Verify(const int requested_lanes,
+                                                  const int rounds) const {
+  auto problems = std::vector<std::string>();
+  auto expected_lanes = std::min(requested_lanes, cars);
+
+  if (heats != cars * rounds) {
+    problems.emplace_back("expected " + std::to_string(cars * rounds) +
+                          " heats, found " + std::to_string(heats));
+  }
+
+  for (int heat = 0; heat < heats; heat++) {
+    if (heat_cars[heat].size() != expected_lanes) {
+      problems.emplace_back("heat " + std::to_string(heat + 1) + " uses " +
+                            std::to_string(heat_cars[heat].size()) + " of " +
+                            std::to_string(expected_lanes) + " lanes");
+    }
+
+    auto distinct{0};
+    for (int word = 0; word < heat_words; word++) {
+      distinct += __builtin_popcountll(heat_bits[heat * heat_words + word]);
+    }
+    if (distinct != heat_cars[heat].size()) {
+      problems.emplace_back("heat " + std::to_string(heat + 1) +
+                            " has a car in more than one lane");
+    }
+  }
+
+  for (int car = 0; car < cars; car++) {
+    for (int lane = 0; lane < expected_lanes; lane++) {
+      if (lane >= lanes || LaneCoverage(car, lane) != rounds) {
+        problems.emplace_back(
+            "car " + std::to_string(car + 1) + " races in lane " +
+            std::to_string(lane + 1) + " " +
+            std::to_string(lane < lanes ? LaneCoverage(car, lane) : 0) +
+            " times");
+      }
+    }
+  }
+
+  return problems;
+}
+
+int ScheduleAnalyzer::SharedCars(const int a, const int b) const {
+  auto shared{0};
+  for (const auto &car : heat_cars[a]) {
+    if (heat_bits[b * heat_words + car / 64] & 1ULL << car % 64) {
+      shared++;
+    }
+  }
+  return shared;
+}
+
+int ScheduleAnalyzer::AdjacentSharedCars(const int first,
+                                         const int second) const {
+  // collect the distinct left heats of every pair touching either heat, so a
+  // pair between first and second is only counted once
+  int pairs[4];
+  auto count{0};
+  for (const auto &left : {first - 1, first, second - 1, second}) {
+    if (left < 0 || left + 1 >= heats ||
+        std::find(pairs, pairs + count, left) != pairs + count) {
+      continue;
+    }
+    pairs[count++] = left;
+  }
+
+  auto shared{0};
+  for (int i = 0; i < count; i++) {
+    shared += SharedCars(pairs[i], pairs[i] + 1);
+  }
+  return shared;
+}
+
+void ScheduleAnalyzer::ToggleMembership(const int car, const int heat) {
+  heat_bits[heat * heat_words + car / 64] ^= 1ULL << car % 64;
+  car_bits[car * car_words + heat / 64] ^= 1ULL << heat % 64;
+}
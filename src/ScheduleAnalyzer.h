@@ -0,0 +1,176 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_SCHEDULEANALYZER_H_
+#define RACINGWEB_SRC_SCHEDULEANALYZER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/Car.h"
+#include "src/schedule.h"
+
+/**
+ * @brief measures how well a schedule meets the generator's goals
+ *
+ * Heats are kept as bitsets of cars and cars as bitsets of heats, so opponent
+ * encounters, back-to-back races and rest gaps come from ANDs and popcounts
+ * over 64 heats or cars at a time.  Lane coverage and encounters do not
+ * depend on heat order, so they are computed once; swapping two heats only
+ * revisits the cars of those two heats and their neighbours, which is
+ * O(lanes) and lets an optimizer try millions of swaps.
+ */
+class ScheduleAnalyzer {
+ public:
+  /**
+   * @brief analyze a schedule
+   * @param roster the cars the schedule points into
+   * @param schedule heats of cars from roster, one car per lane
+   */
+  ScheduleAnalyzer(const std::vector<Car> &roster,
+                   const RaceSchedule &schedule);
+
+  /**
+   * @brief swap the positions of two heats and update the analysis
+   * @param a first heat, 0 <= a < Heats()
+   * @param b second heat, 0 <= b < Heats()
+   */
+  void SwapHeats(int a, int b);
+
+  /**
+   * @brief the analyzed schedule in its current heat order
+   * @return roster indexes of the cars in each heat, by lane
+   */
+  [[nodiscard]] const std::vector<std::vector<int>> &HeatCars() const {
+    return heat_cars;
+  }
+
+  /// @brief number of heats
+  [[nodiscard]] int Heats() const { return heats; }
+
+  /// @brief number of lanes, the size of the largest heat
+  [[nodiscard]] int Lanes() const { return lanes; }
+
+  /**
+   * @brief how many times a car races in a lane
+   * @param car roster index of the car
+   * @param lane the lane
+   * @return number of heats the car races in that lane
+   */
+  [[nodiscard]] int LaneCoverage(const int car, const int lane) const {
+    return lane_coverage[car * lanes + lane];
+  }
+
+  /**
+   * @brief how many heats two cars race against each other
+   * @param a roster index of one car
+   * @param b roster index of the other car
+   * @return number of shared heats, or the car's heat count when a == b
+   */
+  [[nodiscard]] int Encounters(const int a, const int b) const {
+    return encounters[a * cars + b];
+  }
+
+  /**
+   * @brief how many times a car races in two heats in a row
+   * @return the sum over consecutive heat pairs of cars they share
+   */
+  [[nodiscard]] int BackToBack() const { return back_to_back; }
+
+  /**
+   * @brief how many heats cars sit out between races
+   *
+   * Index 0 counts back-to-back races, index 1 counts races with one heat in
+   * between, and so on.  Computed on demand in O(cars * heats / 64).
+   * @return the rest gap histogram
+   */
+  [[nodiscard]] std::vector<int> RestGaps() const;
+
+  /**
+   * @brief overall balance of the schedule, lower is better
+   *
+   * The sum of the average distance of each car's lane counts from an even
+   * split, the standard deviation of opponent encounters, and back-to-back
+   * races per car.  A perfect schedule scores 0.
+   * @return the balance score
+   */
+  [[nodiscard]] double BalanceScore() const;
+
+  /**
+   * @brief check the guarantees the generator makes
+   *
+   * With lanes capped at the number of cars, there must be one heat per car
+   * per round, every lane must be used in every heat, no car may race twice
+   * in one heat, and every car must race in every lane once per round.
+   * @param requested_lanes the number of lanes the schedule was generated for
+   * @param rounds the number of rounds the schedule was generated for
+   * @return a description of every violation, empty if there are none
+   */
+  [[nodiscard]] std::vector<std::string> Verify(int requested_lanes,
+                                                int rounds = 1) const;
+
+ private:
+  /**
+   * @brief count the cars two heats share, using the first heat's cars
+   * @param a first heat
+   * @param b second heat
+   * @return cars racing in both heats
+   */
+  [[nodiscard]] int SharedCars(int a, int b) const;
+
+  /**
+   * @brief back-to-back races on both sides of a set of heats
+   * @param first one heat whose neighbours to count
+   * @param second another heat whose neighbours to count
+   * @return shared cars over each distinct adjacent pair touching the heats
+   */
+  [[nodiscard]] int AdjacentSharedCars(int first, int second) const;
+
+  /**
+   * @brief flip membership of a car in a heat in both bitsets
+   * @param car roster index of the car
+   * @param heat the heat
+   */
+  void ToggleMembership(int car, int heat);
+
+  /// @brief number of cars on the roster
+  int cars;
+
+  /// @brief number of heats
+  int heats;
+
+  /// @brief size of the largest heat
+  int lanes = 0;
+
+  /// @brief 64 bit words in a heat's car bitset
+  int heat_words;
+
+  /// @brief 64 bit words in a car's heat bitset
+  int car_words;
+
+  /// @brief roster indexes of the cars in each heat, by lane
+  std::vector<std::vector<int>> heat_cars;
+
+  /// @brief which cars race in each heat, heat_words per heat
+  std::vector<uint64_t> heat_bits;
+
+  /// @brief which heats each car races in, car_words per car
+  std::vector<uint64_t> car_bits;
+
+  /// @brief races per car per lane, cars rows of lanes columns
+  std::vector<int> lane_coverage;
+
+  /// @brief shared heats per pair of cars, cars rows of cars columns
+  std::vector<int> encounters;
+
+  /// @brief cars shared by consecutive heats
+  int back_to_back = 0;
+
+  /// @brief lane and encounter part of the balance score, fixed by the heats
+  double order_independent_score = 0;
+};
+
+#endif  // RACINGWEB_SRC_SCHEDULEANALYZER_H_
@@ -0,0 +1,137 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/Tournament.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+Division &Tournament::AddDivision(const std::string &name, const int cars,
+                                  const int lanes, const int rounds) {
+  auto roster = std::vector<Car>();
+  for (int i = 0; i < cars; i++) {
+    roster.emplace_back(i + 1);
+  }
+  divisions.emplace_back(
+      std::make_unique<Division>(name, std::move(roster), lanes, rounds));
+  return *divisions.back();
+}
+
+void Tournament::GenerateSchedules() {
+  RACINGWEB_TRACE_SCOPE("Tournament::GenerateSchedules");
+
+  // a single division is not worth a thread
+  if (divisions.size() == 1) {
+    GenerateDivision(*divisions[0]);
+    return;
+  }
+
+  auto workers = std::min<size_t>(
+      divisions.size(), std::max(1u, std::thread::hardware_concurrency()));
+  auto next_division = std::atomic<size_t>(0);
+  auto pool = std::vector<std::thread>();
+  for (size_t i = 0; i < workers; i++) {
+    pool.emplace_back([this, &next_division]() {
+      for (auto d = next_division++; d < divisions.size();
+           d = next_division++) {
+        GenerateDivision(*divisions[d]);
+      }
+    });
+  }
+  for (auto &worker : pool) {
+    worker.join();
+  }
+}
+
+bool Tournament::IsFinished() const {
+  return std::all_of(
+      divisions.begin(), divisions.end(),
+      [](const auto &division) { return IsDivisionFinished(*division); });
+}
+
+Division &Tournament::SeedFinals(const int finalists_per_division,
+                                 const int lanes, const int rounds) {
+  // re-seeding replaces the previous finals
+  if (HasFinals()) {
+    divisions.pop_back();
+  }
+
+  auto roster = std::vector<Car>();
+  for (const auto &division : divisions) {
+    auto standings = CalculateStandings(division->roster, division->results);
+    auto finalists = std::min<size_t>(finalists_per_division, standings.size());
+    for (size_t i = 0; i < finalists; i++) {
+      roster.emplace_back(division->name + "-" + standings[i]->number,
+                          standings[i]->car, standings[i]->driver);
+    }
+  }
+
+  divisions.emplace_back(
+      std::make_unique<Division>("Finals", std::move(roster), lanes, rounds));
+  auto &finals = *divisions.back();
+  finals.finals = true;
+  GenerateDivision(finals);
+  return finals;
+}
+
+void Tournament::GenerateDivision(Division &division) {
+  auto cars = static_cast<int>(division.roster.size());
+  division.analytics.Reset(std::min(division.lanes, cars), cars);
+
+  // free the previous schedule's storage, then give it all back in one step
+  division.schedule = RaceSchedule(&division.arena);
+  division.results = std::pmr::vector<HeatResults>(&division.arena);
+  division.arena.Release();
+
+  // a single round is small enough to generate in full with the pre-generated
+  // charts; more rounds are generated as racing reaches them
+  if (division.rounds == 1) {
+    division.heat_stream.reset();
+    division.schedule =
+        GenerateRaceSchedule(division.roster, division.lanes, &division.arena);
+    division.heat_count = static_cast<int>(division.schedule.size());
+    division.results.resize(division.schedule.size());
+    return;
+  }
+
+  division.heat_stream = std::make_unique<HeatStream>(
+      division.roster, division.lanes, division.rounds);
+  division.heat_count = division.heat_stream->Size();
+
+  // the arena never reuses a block as big as these, so size them once
+  division.schedule.reserve(division.heat_count);
+  division.results.reserve(division.heat_count);
+  MaterializeHeats(division, kHeatLookahead);
+}
+
+void MaterializeHeats(Division &division, const int heats) {
+  if (!division.heat_stream) {
+    return;
+  }
+  while (division.schedule.size() < heats &&
+         division.heat_stream->Generated() < division.heat_count) {
+    auto heat = division.heat_stream->Next();
+    division.schedule.emplace_back(heat.begin(), heat.end());
+    division.results.emplace_back();
+  }
+}
+
+void RetireHeat(Division &division, const int heat) {
+  if (!division.heat_stream) {
+    return;
+  }
+  division.schedule[heat] = Heat(&division.arena);
+}
+
+bool IsDivisionFinished(const Division &division) {
+  return division.schedule.size() == division.heat_count &&
+         std::all_of(division.results.begin(), division.results.end(),
+                     [](const auto &heat) {
+                       return !heat.empty() &&
+                              std::all_of(heat.begin(), heat.end(),
+                                          [](const auto &x) { return !!x; });
+                     });
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_TOURNAMENT_H_
+#define RACINGWEB_SRC_TOURNAMENT_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/Car.h"
+#include "src/HeatStream.h"
+#include "src/RaceAnalytics.h"
+#include "src/RaceArena.h"
+#include "src/Result.h"
+#include "src/raceutil.h"
+#include "src/schedule.h"
+
+/// @brief heats generated ahead of racing: the current heat and the on deck
+constexpr int kHeatLookahead = 2;
+
+/// @brief one race within a tournament, with its own roster and schedule
+struct Division {
+  /**
+   * @brief create a division with an empty schedule
+   * @param name display name of the division
+   * @param roster the cars that race in this division
+   * @param lanes number of lanes to race on
+   * @param rounds how many times each car races in each lane
+   */
+  Division(const std::string &name, std::vector<Car> roster, const int lanes,
+           const int rounds = 1)
+      : name(name), roster(std::move(roster)), lanes(lanes), rounds(rounds) {}
+
+  /// @brief display name of the division
+  std::string name;
+
+  /// @brief the cars that race in this division
+  std::vector<Car> roster;
+
+  /// @brief number of lanes to race on
+  int lanes;
+
+  /// @brief how many times each car races in each lane
+  int rounds;
+
+  /**
+   * @brief holds the schedule and results
+   *
+   * Declared ahead of them so it outlives them, and released whenever the
+   * schedule is regenerated.
+   */
+  RaceArena arena;
+
+  /**
+   * @brief the race schedule, with pointers to cars on the roster
+   *
+   * Single round schedules are generated in full.  Multi-round schedules
+   * only hold the heats generated so far, see MaterializeHeats, and drop the
+   * lineup of each heat once it is accepted, see RetireHeat.  Indexes stay the
+   * same as in results, so a retired heat is an empty entry.
+   */
+  RaceSchedule schedule{&arena};
+
+  /// @brief total number of heats, including any not generated yet
+  int heat_count = 0;
+
+  /// @brief generates the rest of a multi-round schedule as racing advances
+  std::unique_ptr<HeatStream> heat_stream;
+
+  /**
+   * @brief the finish line results
+   *
+   * One empty heat per generated heat is created along with the schedule.  A
+   * heat with a result length of zero has not been run yet.
+   */
+  std::pmr::vector<HeatResults> results{&arena};
+
+  /// @brief lane and head-to-head statistics of the accepted heats
+  RaceAnalytics analytics;
+
+  /// @brief true for the finals seeded from the other divisions
+  bool finals = false;
+};
+
+/**
+ * @brief a set of divisions raced at one event, plus an optional finals round
+ *
+ * Divisions are held by pointer so cars and heats stay where they are while
+ * divisions are added.
+ */
+class Tournament {
+ public:
+  /**
+   * @brief add a division of numbered cars
+   *
+   * Cars are numbered from 1.  The division's schedule is not generated until
+   * GenerateSchedules is called.
+   * @param name display name of the division
+   * @param cars number of cars, 0 < cars
+   * @param lanes number of lanes, 0 < lanes
+   * @param rounds how many times each car races in each lane, 0 < rounds
+   * @return the new division
+   */
+  Division &AddDivision(const std::string &name, int cars, int lanes,
+                        int rounds = 1);
+
+  /**
+   * @brief generate every division's schedule in one parallel batch
+   *
+   * Divisions are independent, so they are handed out to one worker thread
+   * per core.  Any results already recorded are discarded.
+   */
+  void GenerateSchedules();
+
+  /**
+   * @brief seed a finals division from every preliminary division's standings
+   *
+   * The top finalists of each division race again in a newly generated
+   * schedule.  Finalist car numbers are prefixed with their division name so
+   * cars from different divisions can be told apart.  Cars tied at the cutoff
+   * are decided by roster order, see CalculateStandings.
+   * @param finalists_per_division how many cars advance from each division,
+   * 0 < finalists_per_division
+   * @param lanes number of lanes for the finals, 0 < lanes
+   * @param rounds how many times each finalist races in each lane, 0 < rounds
+   * @return the finals division
+   */
+  Division &SeedFinals(int finalists_per_division, int lanes, int rounds = 1);
+
+  /// @brief every division, preliminaries first and finals last
+  [[nodiscard]] const std::vector<std::unique_ptr<Division>> &Divisions()
+      const {
+    return divisions;
+  }
+
+  /// @brief true once a finals division has been seeded
+  [[nodiscard]] bool HasFinals() const {
+    return !divisions.empty() && divisions.back()->finals;
+  }
+
+  /// @brief true once every heat of every division has been accepted
+  [[nodiscard]] bool IsFinished() const;
+
+ private:
+  /**
+   * @brief generate a single division's schedule and empty results
+   *
+   * Any earlier schedule and results are dropped and the division's arena is
+   * released before the new schedule is built in it.
+   * @param division the division to generate
+   */
+  static void GenerateDivision(Division &division);
+
+  /// @brief every division, preliminaries first and finals last
+  std::vector<std::unique_ptr<Division>> divisions;
+};
+
+/**
+ * @brief make sure the first heats of a division have been generated
+ *
+ * Only multi-round divisions generate heats lazily, so this does nothing for
+ * a single round division or once every heat has been generated.
+ * @param division the division to generate heats for
+ * @param heats how many heats must exist
+ */
+void MaterializeHeats(Division &division, int heats);
+
+/**
+ * @brief drop the lineup of an accepted heat
+ *
+ * The results point at roster cars, so standings and statistics do not need
+ * the lineup once a heat is accepted.  Multi-round divisions free it, so only
+ * the heats between the current one and the lookahead are held.  Their
+ * storage goes back to the arena's pool for the next generated heat.  Single
+ * round schedules are generated in full and kept.
+ * @param division the division the heat belongs to
+ * @param heat the accepted heat
+ */
+void RetireHeat(Division &division, int heat);
+
+/**
+ * @brief check whether every heat of a division has been accepted
+ * @param division the division to check
+ * @return true if every heat has complete results
+ */
+bool IsDivisionFinished(const Division &division);
+
+#endif  // RACINGWEB_SRC_TOURNAMENT_H_
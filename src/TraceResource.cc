@@ -0,0 +1,16 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/TraceResource.h"
+
+TraceResource::~TraceResource() { beingDeleted(); }
+
+void TraceResource::handleRequest(const Wt::Http::Request &request,
+                                  Wt::Http::Response &response) {
+  response.setMimeType("application/json");
+  response.addHeader("Content-Disposition",
+                     "attachment; filename=racingweb-trace.json");
+  WriteChromeTrace(response.out());
+}
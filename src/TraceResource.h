@@ -0,0 +1,33 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_TRACERESOURCE_H_
+#define RACINGWEB_SRC_TRACERESOURCE_H_
+
+#include <Wt/Http/Request.h>
+#include <Wt/Http/Response.h>
+#include <Wt/WResource.h>
+
+#include "src/trace.h"
+
+/**
+ * @brief serves the buffered trace spans as chrome trace-event json
+ *
+ * Only mounted when the server is built with RACINGWEB_TRACING.
+ */
+class TraceResource : public Wt::WResource {
+ public:
+  ~TraceResource() override;
+
+  /**
+   * @brief write every buffered span
+   * @param request the dump request (unused)
+   * @param response receives the trace as a json download
+   */
+  void handleRequest(const Wt::Http::Request &request,
+                     Wt::Http::Response &response) override;
+};
+
+#endif  // RACINGWEB_SRC_TRACERESOURCE_H_
@@ -3,12 +3,31 @@
 // See LICENSE for details.
 /// @file
 
+#include <Wt/WServer.h>
+
+#include <iostream>
+#include <memory>
 #include <vector>
 
+#include "src/MetricsResource.h"
 #include "src/RacingWebApplication.h"
+#include "src/TraceResource.h"
 
 int main(int argc, char **argv) {
-  return Wt::WRun(argc, argv, [](const Wt::WEnvironment &env) {
-    return std::make_unique<RacingWebApplication>(env);
-  });
+  try {
+    Wt::WServer server(argc, argv, WTHTTP_CONFIGURATION);
+    server.addEntryPoint(Wt::EntryPointType::Application,
+                         [](const Wt::WEnvironment &env) {
+                           return std::make_unique<RacingWebApplication>(env);
+                         });
+    server.addResource(std::make_shared<MetricsResource>(), "/metrics");
+#ifdef RACINGWEB_TRACING
+    server.addResource(std::make_shared<TraceResource>(), "/trace.json");
+#endif
+    server.run();
+  } catch (Wt::WServerException const &server_exception) {
+    std::cerr << server_exception.what() << std::endl;
+    return 1;
+  }
+  return 0;
 }
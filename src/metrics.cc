@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/metrics.h"
+
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr auto kCounters = static_cast<size_t>(Counter::kCount);
+constexpr auto kGauges = static_cast<size_t>(Gauge::kCount);
+constexpr auto kHistograms = static_cast<size_t>(Histogram::kCount);
+
+/// @brief upper bounds of the histogram buckets, in nanoseconds
+constexpr std::array<int64_t, 16> kBucketBounds{
+    10'000,     25'000,     50'000,      100'000,     250'000,     500'000,
+    1'000'000,  2'500'000,  5'000'000,   10'000'000,  25'000'000,  50'000'000,
+    100'000'000, 250'000'000, 500'000'000, 1'000'000'000};
+
+/// @brief metric name and help text
+struct MetricInfo {
+  const char *name;
+  const char *help;
+};
+
+constexpr std::array<MetricInfo, kCounters> kCounterInfo{{
+    {"racingweb_heats_completed_total", "Heats whose results were accepted."},
+    {"racingweb_schedules_generated_total", "Race schedules generated."},
+    {"racingweb_arena_allocations_total",
+     "Heat and result allocations served from race arenas."},
+    {"racingweb_arena_chunks_total", "Chunks race arenas took from the heap."},
+}};
+
+constexpr std::array<MetricInfo, kGauges> kGaugeInfo{{
+    {"racingweb_active_sessions", "Open RacingWebApplication sessions."},
+    {"racingweb_active_races", "Sessions with a race that is not finished."},
+    {"racingweb_arena_bytes", "Heap memory held by race arenas."},
+}};
+
+constexpr std::array<MetricInfo, kHistograms> kHistogramInfo{{
+    {"racingweb_schedule_generation_seconds",
+     "Time to generate a schedule and show it."},
+    {"racingweb_mark_place_seconds", "Time to handle a place button click."},
+    {"racingweb_accept_results_seconds",
+     "Time to accept a heat and show the next one."},
+}};
+
+/**
+ * @brief one thread's metrics
+ *
+ * Only the owning thread writes to a shard, so updates are a relaxed load and
+ * store instead of a locked read-modify-write.  The scraping thread only
+ * reads.
+ */
+struct Shard {
+  std::array<std::atomic<uint64_t>, kCounters> counters{};
+  std::array<std::atomic<int64_t>, kGauges> gauges{};
+  std::array<std::array<std::atomic<uint64_t>, kBucketBounds.size() + 1>,
+             kHistograms>
+      buckets{};
+  std::array<std::atomic<uint64_t>, kHistograms> sum_ns{};
+};
+
+/// @brief guards shards, which is only touched on thread start, exit and scrape
+std::mutex shards_mutex;
+
+/**
+ * @brief every shard ever created
+ *
+ * Shards outlive their threads so totals survive a thread pool shrinking.
+ */
+std::vector<std::unique_ptr<Shard>> shards;
+
+/**
+ * @brief shards whose threads have exited
+ *
+ * A new thread takes one of these before creating a shard, so short lived
+ * threads do not grow shards without bound.  A recycled shard keeps its
+ * totals, which is fine since every shard is summed on scrape.
+ */
+std::vector<Shard *> free_shards;
+
+/// @brief lends a shard to one thread and takes it back when the thread exits
+class ShardLease {
+ public:
+  ShardLease() {
+    std::lock_guard<std::mutex> lock(shards_mutex);
+    if (free_shards.empty()) {
+      shards.emplace_back(std::make_unique<Shard>());
+      shard = shards.back().get();
+    } else {
+      shard = free_shards.back();
+      free_shards.pop_back();
+    }
+  }
+
+  ShardLease(const ShardLease &) = delete;
+  ShardLease &operator=(const ShardLease &) = delete;
+
+  ~ShardLease() {
+    std::lock_guard<std::mutex> lock(shards_mutex);
+    free_shards.emplace_back(shard);
+  }
+
+  /// @brief the shard only this thread writes to
+  Shard *shard;
+};
+
+/**
+ * @brief find the calling thread's shard, leasing one on first use
+ * @return the calling thread's shard
+ */
+Shard &LocalShard() {
+  thread_local ShardLease lease;
+  return *lease.shard;
+}
+
+/**
+ * @brief add to an atomic that only the calling thread writes
+ * @param value the atomic to change
+ * @param amount how much to add
+ */
+template <typename T>
+void SingleWriterAdd(std::atomic<T> &value, const T amount) {
+  value.store(value.load(std::memory_order_relaxed) + amount,
+              std::memory_order_relaxed);
+}
+
+/**
+ * @brief read the resident set size of this process
+ * @return resident memory in bytes, or 0 if unavailable
+ */
+int64_t ResidentMemoryBytes() {
+  auto statm = std::ifstream("/proc/self/statm");
+  int64_t size{0}, resident{0};
+  if (!(statm >> size >> resident)) {
+    return 0;
+  }
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+}  // namespace
+
+void IncrementCounter(const Counter counter, const uint64_t amount) {
+  SingleWriterAdd(LocalShard().counters[static_cast<size_t>(counter)], amount);
+}
+
+void AdjustGauge(const Gauge gauge, const int64_t delta) {
+  SingleWriterAdd(LocalShard().gauges[static_cast<size_t>(gauge)], delta);
+}
+
+void ObserveLatency(const Histogram histogram,
+                    const std::chrono::nanoseconds elapsed) {
+  auto &shard = LocalShard();
+  auto index = static_cast<size_t>(histogram);
+
+  size_t bucket{0};
+  while (bucket < kBucketBounds.size() &&
+         elapsed.count() > kBucketBounds[bucket]) {
+    bucket++;
+  }
+
+  SingleWriterAdd(shard.buckets[index][bucket], uint64_t{1});
+  SingleWriterAdd(shard.sum_ns[index],
+                  static_cast<uint64_t>(elapsed.count()));
+}
+
+void WriteMetrics(std::ostream &out) {
+  std::array<uint64_t, kCounters> counters{};
+  std::array<int64_t, kGauges> gauges{};
+  std::array<std::array<uint64_t, kBucketBounds.size() + 1>, kHistograms>
+      buckets{};
+  std::array<uint64_t, kHistograms> sum_ns{};
+
+  {
+    std::lock_guard<std::mutex> lock(shards_mutex);
+    for (const auto &shard : shards) {
+      for (size_t i = 0; i < kCounters; i++) {
+        counters[i] += shard->counters[i].load(std::memory_order_relaxed);
+      }
+      for (size_t i = 0; i < kGauges; i++) {
+        gauges[i] += shard->gauges[i].load(std::memory_order_relaxed);
+      }
+      for (size_t i = 0; i < kHistograms; i++) {
+        for (size_t b = 0; b < buckets[i].size(); b++) {
+          buckets[i][b] +=
+              shard->buckets[i][b].load(std::memory_order_relaxed);
+        }
+        sum_ns[i] += shard->sum_ns[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < kCounters; i++) {
+    out << "# HELP " << kCounterInfo[i].name << " " << kCounterInfo[i].help
+        << "\n# TYPE " << kCounterInfo[i].name << " counter\n"
+        << kCounterInfo[i].name << " " << counters[i] << "\n";
+  }
+
+  for (size_t i = 0; i < kGauges; i++) {
+    out << "# HELP " << kGaugeInfo[i].name << " " << kGaugeInfo[i].help
+        << "\n# TYPE " << kGaugeInfo[i].name << " gauge\n"
+        << kGaugeInfo[i].name << " " << gauges[i] << "\n";
+  }
+
+  out << "# HELP racingweb_resident_memory_bytes Resident memory of the "
+         "server process.\n"
+         "# TYPE racingweb_resident_memory_bytes gauge\n"
+         "racingweb_resident_memory_bytes "
+      << ResidentMemoryBytes() << "\n";
+
+  for (size_t i = 0; i < kHistograms; i++) {
+    const auto name = kHistogramInfo[i].name;
+    out << "# HELP " << name << " " << kHistogramInfo[i].help << "\n# TYPE "
+        << name << " histogram\n";
+    uint64_t cumulative{0};
+    for (size_t b = 0; b < kBucketBounds.size(); b++) {
+      cumulative += buckets[i][b];
+      out << name << "_bucket{le=\"" << kBucketBounds[b] / 1e9 << "\"} "
+          << cumulative << "\n";
+    }
+    cumulative += buckets[i].back();
+    out << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n"
+        << name << "_sum " << sum_ns[i] / 1e9 << "\n"
+        << name << "_count " << cumulative << "\n";
+  }
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_METRICS_H_
+#define RACINGWEB_SRC_METRICS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/// @brief monotonically increasing counters
+enum class Counter {
+  kHeatsCompleted,
+  kSchedulesGenerated,
+  kArenaAllocations,
+  kArenaChunks,
+  kCount,
+};
+
+/// @brief values that go up and down
+enum class Gauge {
+  kActiveSessions,
+  kActiveRaces,
+  kArenaBytes,
+  kCount,
+};
+
+/// @brief latency histograms for the hot paths
+enum class Histogram {
+  kScheduleGeneration,
+  kMarkPlace,
+  kAcceptResults,
+  kCount,
+};
+
+/**
+ * @brief add to a counter
+ *
+ * Every thread records into its own shard, so this is a plain relaxed load
+ * and store with no lock and no contended cache line.
+ * @param counter which counter to increase
+ * @param amount how much to add
+ */
+void IncrementCounter(Counter counter, uint64_t amount = 1);
+
+/**
+ * @brief move a gauge up or down
+ * @param gauge which gauge to change
+ * @param delta how much to add, negative to subtract
+ */
+void AdjustGauge(Gauge gauge, int64_t delta);
+
+/**
+ * @brief record one observation in a latency histogram
+ * @param histogram which histogram to record into
+ * @param elapsed how long the observed operation took
+ */
+void ObserveLatency(Histogram histogram, std::chrono::nanoseconds elapsed);
+
+/**
+ * @brief write every metric in the prometheus text exposition format
+ *
+ * Shards from all threads are summed while they are being written to, so a
+ * scrape is a consistent-enough snapshot rather than an atomic one.
+ * @param out where to write the metrics
+ */
+void WriteMetrics(std::ostream &out);
+
+/// @brief records the lifetime of a scope into a latency histogram
+class ScopedLatency {
+ public:
+  /**
+   * @brief start timing
+   * @param histogram where to record the elapsed time on destruction
+   */
+  explicit ScopedLatency(const Histogram histogram)
+      : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+
+  ScopedLatency(const ScopedLatency &) = delete;
+  ScopedLatency &operator=(const ScopedLatency &) = delete;
+
+  ~ScopedLatency() {
+    ObserveLatency(histogram, std::chrono::steady_clock::now() - start);
+  }
+
+ private:
+  /// @brief where to record the elapsed time
+  Histogram histogram;
+
+  /// @brief when timing began
+  std::chrono::steady_clock::time_point start;
+};
+
+#endif  // RACINGWEB_SRC_METRICS_H_
@@ -7,6 +7,7 @@
 
 std::vector<std::vector<const Car *>> LoadPreGeneratedSchedule(
     const std::vector<Car> &roster) {
+  RACINGWEB_TRACE_SCOPE("LoadPreGeneratedSchedule");
   auto cars = roster.size();
   auto schedule{std::vector<std::vector<const Car *>>()};
 
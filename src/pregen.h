@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "src/Car.h"
+#include "src/trace.h"
 
 /**
  * spits out a pre-generated schedule for 4 lanes using a more optimal pattern
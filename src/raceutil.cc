@@ -5,14 +5,41 @@
 
 #include "src/raceutil.h"
 
-bool DoAnyCarsMatch(std::vector<const Car *> const &a,
-                    std::vector<const Car *> const &b) {
-  for (const auto &item_a : a) {
-    for (const auto &item_b : b) {
-      if (item_a == item_b) {
-        return true;
+#include <array>
+#include <cstddef>
+
+std::vector<const Car *> CalculateStandings(
+    const std::vector<Car> &roster,
+    const std::pmr::vector<HeatResults> &results) {
+  RACINGWEB_TRACE_SCOPE("CalculateStandings");
+  auto final_standings = std::vector<const Car *>();
+  for (const auto &item : roster) {
+    final_standings.emplace_back(&item);
+  }
+
+  // create map to store score calculations in, on the stack unless the
+  // roster is too big for it
+  std::array<std::byte, 8192> scratch_buffer;
+  auto scratch = std::pmr::monotonic_buffer_resource(scratch_buffer.data(),
+                                                     scratch_buffer.size());
+  auto scores = std::pmr::map<const Car *, int>(&scratch);
+  std::for_each(roster.begin(), roster.end(),
+                [&scores](const auto &x) { scores[&x] = 0; });
+
+  // add up the results, skipping lanes of a heat still being marked
+  for (const auto &heat : results) {
+    std::for_each(heat.begin(), heat.end(), [&scores](const auto &x) {
+      if (x) {
+        scores[x->car] += x->place;
       }
-    }
+    });
   }
-  return false;
+
+  // final standings sort, stable so tied cars keep their roster order
+  std::stable_sort(final_standings.begin(), final_standings.end(),
+                   [&scores](const auto &a, const auto &b) {
+                     return scores[a] < scores[b];
+                   });
+
+  return final_standings;
 }
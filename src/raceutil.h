@@ -6,17 +6,47 @@
 #ifndef RACINGWEB_SRC_RACEUTIL_H_
 #define RACINGWEB_SRC_RACEUTIL_H_
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include "src/Car.h"
+#include "src/Result.h"
+#include "src/trace.h"
 
 /**
- * checks if any cars in the two vectors provided are the same object
+ * checks if any cars in the two heats provided are the same object
  * @param a left operand to compare
  * @param b right operand to compare
- * @return true if any cars in either vector are the same object
+ * @return true if any cars in either heat are the same object
  */
-bool DoAnyCarsMatch(std::vector<const Car *> const &a,
-                    std::vector<const Car *> const &b);
+template <typename HeatA, typename HeatB>
+bool DoAnyCarsMatch(HeatA const &a, HeatB const &b) {
+  for (const auto &item_a : a) {
+    for (const auto &item_b : b) {
+      if (item_a == item_b) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief read results and return an ordered vector of winners
+ *
+ * the car in index 0 came in first place, index 1 is second place, and so on.
+ * Places are summed across every heat and the lowest total wins.  Cars with
+ * the same total are ranked in roster order, so the standings, and the
+ * finalists seeded from them, do not depend on the sort implementation.
+ * @param roster the cars that raced
+ * @param results the finish line results of every heat
+ * @return the ordered list of winners
+ */
+std::vector<const Car *> CalculateStandings(
+    const std::vector<Car> &roster,
+    const std::pmr::vector<HeatResults> &results);
 
 #endif  // RACINGWEB_SRC_RACEUTIL_H_
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/schedule.h"
+
+#include <utility>
+
+RaceSchedule GenerateRaceSchedule(const std::vector<Car> &roster, int lanes,
+                                  std::pmr::memory_resource *resource) {
+  RACINGWEB_TRACE_SCOPE("GenerateRaceSchedule");
+  auto cars = static_cast<int>(roster.size());
+
+  // cap the number of lanes at the number of cars
+  if (lanes > cars) {
+    lanes = cars;
+  }
+
+  auto initial_schedule{RaceSchedule(resource)};
+  initial_schedule.reserve(cars);
+  if (lanes == 4 && cars <= 13) {
+    // use pre-generated races for 4 lane tracks up to 13 racers
+    for (const auto &heat : LoadPreGeneratedSchedule(roster)) {
+      initial_schedule.emplace_back(heat.begin(), heat.end());
+    }
+  } else {
+    // generate the race schedule
+    for (int i = 0; i < cars; i++) {
+      auto &heat = initial_schedule.emplace_back();
+      heat.reserve(lanes);
+      for (int lane = 0; lane < lanes; lane++) {
+        heat.emplace_back(&roster[(i + lane) % cars]);
+      }
+    }
+  }
+
+  // try to arrange the schedule so that cars are not in adjacent heats.  heats
+  // are moved rather than copied, so each is only allocated once.
+  auto schedule{RaceSchedule(resource)};
+  schedule.reserve(initial_schedule.size());
+
+  // move the first heat into the optimized_schedule
+  schedule.emplace_back(std::move(initial_schedule[0]));
+  initial_schedule.erase(initial_schedule.begin());
+
+  // populate the optimized_schedule, preferring arrangements where the
+  // cars are not in adjacent heats
+  for (int i = 1; i < cars; i++) {
+    int next_heat{0};
+
+    // look for a better next heat, if possible by comparing with the
+    // previous heat in the optimized schedule
+    for (int proposed_idx = 0; proposed_idx < initial_schedule.size();
+         proposed_idx++) {
+      if (!DoAnyCarsMatch(schedule[i - 1], initial_schedule[proposed_idx])) {
+        next_heat = proposed_idx;
+        break;
+      }
+    }
+
+    // move the next heat into the optimized schedule
+    schedule.emplace_back(std::move(initial_schedule[next_heat]));
+    initial_schedule.erase(initial_schedule.begin() + next_heat);
+  }
+
+  return schedule;
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_SCHEDULE_H_
+#define RACINGWEB_SRC_SCHEDULE_H_
+
+#include <memory_resource>
+#include <vector>
+
+#include "src/Car.h"
+#include "src/pregen.h"
+#include "src/raceutil.h"
+#include "src/trace.h"
+
+/// @brief one car per lane, pointing into a roster
+using Heat = std::pmr::vector<const Car *>;
+
+/// @brief every heat of a race, in running order
+using RaceSchedule = std::pmr::vector<Heat>;
+
+/**
+ * @brief generate a race schedule for a roster
+ *
+ * Every car races once in every lane and there are as many heats as cars.
+ * Four lane races of up to 13 cars use the pre-generated charts, all others
+ * use a left rotation.  Heats are then re-ordered to try and avoid a car
+ * racing in two heats in a row.
+ * @param roster the cars to race, must not be empty; the schedule points into
+ * it, so it must outlive the schedule and not be resized
+ * @param lanes number of lanes, 0 < lanes, capped at roster.size()
+ * @param resource where the schedule and the heats being reordered live
+ * @return completed race schedule as a vector of heats, each heat consisting
+ * of one car per lane
+ */
+RaceSchedule GenerateRaceSchedule(
+    const std::vector<Car> &roster, int lanes,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+#endif  // RACINGWEB_SRC_SCHEDULE_H_
@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include "src/trace.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/// @brief spans kept per thread before the oldest are overwritten
+constexpr size_t kRingCapacity = 1 << 16;
+
+/**
+ * @brief one recorded span
+ *
+ * Fields are relaxed atomics so a dump can read a slot while its thread
+ * overwrites it without undefined behaviour; a torn span is discarded using
+ * the ring's head position.
+ */
+struct TraceEvent {
+  std::atomic<const char *> name{nullptr};
+  std::atomic<int64_t> start_ns{0};
+  std::atomic<int64_t> duration_ns{0};
+};
+
+/// @brief one thread's spans, written only by that thread
+struct TraceRing {
+  explicit TraceRing(const int tid) : tid(tid) {}
+
+  /// @brief sequential thread id shown in the trace viewer
+  int tid;
+  /// @brief total spans ever written; the next slot is head % capacity
+  std::atomic<uint64_t> head{0};
+  /// @brief span storage
+  std::array<TraceEvent, kRingCapacity> events;
+};
+
+/// @brief guards rings, which is only touched on thread start, exit and dump
+std::mutex rings_mutex;
+
+/// @brief every ring ever created, kept after its thread exits
+std::vector<std::unique_ptr<TraceRing>> rings;
+
+/**
+ * @brief rings whose threads have exited
+ *
+ * A new thread takes one of these before creating a ring, so short lived
+ * threads only ever cost as many rings as were alive at once.  The new
+ * thread's spans carry on after the old thread's under the same tid.
+ */
+std::vector<TraceRing *> free_rings;
+
+/// @brief lends a ring to one thread and takes it back when the thread exits
+class RingLease {
+ public:
+  RingLease() {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    if (free_rings.empty()) {
+      rings.emplace_back(
+          std::make_unique<TraceRing>(static_cast<int>(rings.size()) + 1));
+      ring = rings.back().get();
+    } else {
+      ring = free_rings.back();
+      free_rings.pop_back();
+    }
+  }
+
+  RingLease(const RingLease &) = delete;
+  RingLease &operator=(const RingLease &) = delete;
+
+  ~RingLease() {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    free_rings.emplace_back(ring);
+  }
+
+  /// @brief the ring only this thread writes to
+  TraceRing *ring;
+};
+
+/**
+ * @brief find the calling thread's ring, leasing one on first use
+ * @return the calling thread's ring
+ */
+TraceRing &LocalRing() {
+  thread_local RingLease lease;
+  return *lease.ring;
+}
+
+/**
+ * @brief nanoseconds on the steady clock
+ * @param time a point on the steady clock
+ * @return nanoseconds since the clock's epoch
+ */
+int64_t Nanoseconds(const std::chrono::steady_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void RecordTraceSpan(const char *name,
+                     const std::chrono::steady_clock::time_point start,
+                     const std::chrono::steady_clock::time_point end) {
+  auto &ring = LocalRing();
+  auto head = ring.head.load(std::memory_order_relaxed);
+  auto &event = ring.events[head % kRingCapacity];
+  event.name.store(name, std::memory_order_relaxed);
+  event.start_ns.store(Nanoseconds(start), std::memory_order_relaxed);
+  event.duration_ns.store(Nanoseconds(end) - Nanoseconds(start),
+                          std::memory_order_relaxed);
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+void WriteChromeTrace(std::ostream &out) {
+  std::lock_guard<std::mutex> lock(rings_mutex);
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  auto first{true};
+  for (const auto &ring : rings) {
+    auto head = ring->head.load(std::memory_order_acquire);
+    auto begin = head > kRingCapacity ? head - kRingCapacity : 0;
+    for (auto i = begin; i < head; i++) {
+      const auto &event = ring->events[i % kRingCapacity];
+      auto name = event.name.load(std::memory_order_relaxed);
+      auto start_ns = event.start_ns.load(std::memory_order_relaxed);
+      auto duration_ns = event.duration_ns.load(std::memory_order_relaxed);
+
+      // the owning thread may have lapped this slot while we were reading
+      auto now_head = ring->head.load(std::memory_order_acquire);
+      if (now_head > kRingCapacity && i < now_head - kRingCapacity + 1) {
+        continue;
+      }
+
+      out << (first ? "" : ",") << "{\"name\":\"" << name
+          << "\",\"cat\":\"racingweb\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+          << ring->tid << ",\"ts\":" << start_ns / 1000 << "."
+          << (start_ns % 1000) / 100 << ",\"dur\":" << duration_ns / 1000
+          << "." << (duration_ns % 1000) / 100 << "}";
+      first = false;
+    }
+  }
+  out << "]}";
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#ifndef RACINGWEB_SRC_TRACE_H_
+#define RACINGWEB_SRC_TRACE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief record a completed span in the calling thread's ring buffer
+ *
+ * Once the buffer is full the oldest spans are overwritten.
+ * @param name span name, must be a string literal
+ * @param start when the span began
+ * @param end when the span ended
+ */
+void RecordTraceSpan(const char *name,
+                     std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end);
+
+/**
+ * @brief write every buffered span as chrome trace-event json
+ *
+ * The output can be loaded in Perfetto or chrome://tracing.  Spans recorded
+ * while the dump runs may or may not be included.
+ * @param out where to write the json
+ */
+void WriteChromeTrace(std::ostream &out);
+
+/// @brief records the lifetime of a scope as a trace span
+class TraceSpan {
+ public:
+  /**
+   * @brief open a span
+   * @param name span name, must be a string literal
+   */
+  explicit TraceSpan(const char *name)
+      : name(name), start(std::chrono::steady_clock::now()) {}
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+  ~TraceSpan() {
+    RecordTraceSpan(name, start, std::chrono::steady_clock::now());
+  }
+
+ private:
+  /// @brief span name
+  const char *name;
+
+  /// @brief when the span began
+  std::chrono::steady_clock::time_point start;
+};
+
+#define RACINGWEB_TRACE_JOIN_(a, b) a##b
+#define RACINGWEB_TRACE_JOIN(a, b) RACINGWEB_TRACE_JOIN_(a, b)
+
+/**
+ * @brief trace the rest of the enclosing scope
+ *
+ * Expands to nothing unless the build defines RACINGWEB_TRACING, so spans
+ * cost nothing in a normal build.
+ */
+#ifdef RACINGWEB_TRACING
+#define RACINGWEB_TRACE_SCOPE(name) \
+  TraceSpan RACINGWEB_TRACE_JOIN(trace_span_, __LINE__)(name)
+#else
+#define RACINGWEB_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif  // RACINGWEB_SRC_TRACE_H_
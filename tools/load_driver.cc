@@ -0,0 +1,676 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief command line settings for a load run
+struct DriverOptions {
+  /// @brief host the racingweb server listens on
+  std::string host = "127.0.0.1";
+  /// @brief port the racingweb server listens on
+  std::string port = "8080";
+  /// @brief simulated operators entering results
+  int operators = 4;
+  /// @brief simulated spectators that only hold a session open
+  int idle_spectators = 0;
+  /// @brief simulated spectators that poll for updates
+  int polling_spectators = 16;
+  /// @brief how long to apply load, in seconds
+  int duration = 60;
+  /// @brief pause between operator clicks, in milliseconds
+  int think_ms = 2000;
+  /// @brief pause between spectator polls, in milliseconds
+  int poll_ms = 5000;
+  /// @brief pid of the server, used to sample its memory (0 to skip)
+  int pid = 0;
+};
+
+/// @brief a parsed http response
+struct HttpResponse {
+  /// @brief http status code, or 0 if the request failed
+  int status = 0;
+  /// @brief response headers and body as received
+  std::string raw;
+};
+
+/**
+ * @brief minimal blocking http/1.1 client
+ *
+ * Every request uses its own connection and reads until the server closes it,
+ * which keeps the client trivial and still exercises the server's accept path
+ * the way short-lived mobile connections do.  Cookies set by the server are
+ * returned on later requests so cookie based session tracking also works.
+ */
+class HttpClient {
+ public:
+  /**
+   * @brief create a client for one simulated browser
+   * @param host server host name or address
+   * @param port server port
+   */
+  HttpClient(const std::string &host, const std::string &port)
+      : host(host), port(port) {}
+
+  /**
+   * @brief send a GET request
+   * @param target path and query string
+   * @return the response
+   */
+  HttpResponse Get(const std::string &target) {
+    return Send("GET " + target + " HTTP/1.1\r\n" + Headers() + "\r\n");
+  }
+
+  /**
+   * @brief send a form encoded POST request
+   * @param target path and query string
+   * @param body url encoded form body
+   * @return the response
+   */
+  HttpResponse Post(const std::string &target, const std::string &body) {
+    return Send("POST " + target + " HTTP/1.1\r\n" + Headers() +
+                "Content-Type: application/x-www-form-urlencoded\r\n"
+                "Content-Length: " +
+                std::to_string(body.size()) + "\r\n\r\n" + body);
+  }
+
+ private:
+  /**
+   * @brief headers common to every request
+   * @return header lines, each terminated with CRLF
+   */
+  std::string Headers() const {
+    auto headers = "Host: " + host + ":" + port +
+                   "\r\nUser-Agent: Mozilla/5.0 racingweb-load-driver"
+                   "\r\nConnection: close\r\n";
+    if (!cookie.empty()) {
+      headers += "Cookie: " + cookie + "\r\n";
+    }
+    return headers;
+  }
+
+  /**
+   * @brief write a request and read the whole response
+   * @param request the complete request
+   * @return the response, with status 0 on connection failure
+   */
+  HttpResponse Send(const std::string &request) {
+    auto response = HttpResponse();
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+      return response;
+    }
+
+    auto fd{-1};
+    for (auto address = addresses; address; address = address->ai_next) {
+      fd = socket(address->ai_family, address->ai_socktype,
+                  address->ai_protocol);
+      if (fd < 0) {
+        continue;
+      }
+      if (connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+        break;
+      }
+      close(fd);
+      fd = -1;
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) {
+      return response;
+    }
+
+    timeval timeout{30, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    for (size_t sent = 0; sent < request.size();) {
+      auto written = send(fd, request.data() + sent, request.size() - sent,
+                          MSG_NOSIGNAL);
+      if (written <= 0) {
+        close(fd);
+        return response;
+      }
+      sent += written;
+    }
+
+    char buffer[16384];
+    for (auto received = recv(fd, buffer, sizeof(buffer), 0); received > 0;
+         received = recv(fd, buffer, sizeof(buffer), 0)) {
+      response.raw.append(buffer, received);
+    }
+    close(fd);
+
+    // "HTTP/1.1 200 OK"
+    if (response.raw.size() > 12 && response.raw.compare(0, 5, "HTTP/") == 0) {
+      response.status = std::atoi(response.raw.c_str() + 9);
+    }
+
+    static const std::regex set_cookie("Set-Cookie: ([^;\r\n]+)",
+                                       std::regex::icase);
+    std::smatch match;
+    auto headers = response.raw.substr(0, response.raw.find("\r\n\r\n"));
+    if (std::regex_search(headers, match, set_cookie)) {
+      cookie = match[1];
+    }
+
+    return response;
+  }
+
+  /// @brief server host name or address
+  std::string host;
+
+  /// @brief server port
+  std::string port;
+
+  /// @brief last cookie set by the server
+  std::string cookie;
+};
+
+/**
+ * @brief thread safe collection of request latencies
+ */
+class LatencyLog {
+ public:
+  /**
+   * @brief record a completed request
+   * @param kind what kind of request this was
+   * @param milliseconds how long the request took
+   * @param response the response that was received
+   */
+  void Record(const std::string &kind, const double milliseconds,
+              const HttpResponse &response) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &entry = entries[kind];
+    if (response.status == 200) {
+      entry.latencies.emplace_back(milliseconds);
+      entry.bytes += response.raw.size();
+    } else {
+      entry.errors++;
+    }
+  }
+
+  /**
+   * @brief write latency percentiles and throughput for each request kind
+   * @param out where to write the report
+   * @param seconds how long the load was applied
+   */
+  void Report(std::ostream &out, const double seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    out << std::left << std::setw(12) << "request (ms)" << std::right
+        << std::setw(8) << "ok" << std::setw(8) << "errors" << std::setw(10)
+        << "req/s" << std::setw(10) << "p50" << std::setw(10) << "p95"
+        << std::setw(10) << "p99" << std::setw(10) << "max" << std::setw(12)
+        << "KiB/s" << std::endl;
+    out << std::fixed << std::setprecision(1);
+    for (auto &[kind, entry] : entries) {
+      auto &values = entry.latencies;
+      std::sort(values.begin(), values.end());
+      out << std::left << std::setw(12) << kind << std::right << std::setw(8)
+          << values.size() << std::setw(8) << entry.errors << std::setw(10)
+          << values.size() / seconds << std::setw(10) << Percentile(values, 50)
+          << std::setw(10) << Percentile(values, 95) << std::setw(10)
+          << Percentile(values, 99) << std::setw(10)
+          << (values.empty() ? 0.0 : values.back()) << std::setw(12)
+          << entry.bytes / 1024.0 / seconds << std::endl;
+    }
+  }
+
+ private:
+  /// @brief latencies and counters for one kind of request
+  struct Entry {
+    /// @brief latency of each successful request, in milliseconds
+    std::vector<double> latencies;
+    /// @brief failed requests
+    int errors = 0;
+    /// @brief bytes received from successful requests
+    size_t bytes = 0;
+  };
+
+  /**
+   * @brief nearest-rank percentile of sorted values
+   * @param values sorted values
+   * @param percent which percentile, 0 < percent <= 100
+   * @return the percentile value, or 0 if there are no values
+   */
+  static double Percentile(const std::vector<double> &values,
+                           const int percent) {
+    if (values.empty()) {
+      return 0;
+    }
+    auto rank = (values.size() * percent + 99) / 100;
+    return values[rank > 0 ? rank - 1 : 0];
+  }
+
+  /// @brief guards entries
+  std::mutex mutex;
+
+  /// @brief entries keyed by request kind
+  std::map<std::string, Entry> entries;
+};
+
+/**
+ * @brief one simulated browser talking to racingweb over Wt's ajax protocol
+ *
+ * A session is bootstrapped with a plain GET, which answers with the Wt
+ * bootstrap page carrying the session id and the url of the application
+ * script, including the script id (sid) Wt checks.  Loading that script
+ * creates the RacingWebApplication, and every later interaction is a
+ * "jsupdate" POST that acknowledges the last update and optionally carries a
+ * signal.
+ *
+ * Operators follow the race script: generate a schedule with the setup tab's
+ * defaults, click one place per lane of the current heat, accept it, and
+ * generate again once the last heat is accepted.  Buttons are found by the
+ * object names RacingWebApplication gives them ("generate", "d0-h3-l1-p2",
+ * "d0-h3-accept"), which are scraped along with their signals from the
+ * javascript the server sends.  Names carry the heat, so the hidden on-deck
+ * grid, tabs and "Clear Results" are never clicked, and a heat's buttons are
+ * forgotten once it is accepted.
+ */
+class SimulatedBrowser {
+ public:
+  /**
+   * @brief create a browser that has not connected yet
+   * @param options server location and pacing
+   * @param log where request latencies are recorded
+   * @param seed random seed for the order places are handed out
+   */
+  SimulatedBrowser(const DriverOptions &options, LatencyLog &log,
+                   const unsigned int seed)
+      : client(options.host, options.port), log(log), random(seed) {}
+
+  /**
+   * @brief bootstrap a session and load the application
+   * @return true if the application loaded
+   */
+  bool Start() {
+    auto bootstrap = Request("bootstrap", "/", "");
+    static const std::regex session_id("wtd=([A-Za-z0-9]+)");
+    static const std::regex script_url(
+        "[\"'](/?\\?[^\"']*request=script[^\"']*)[\"']");
+    static const std::regex script_id("\\bsid\\W{1,6}(-?[0-9]+)");
+    std::smatch match;
+    if (!std::regex_search(bootstrap.raw, match, session_id)) {
+      return false;
+    }
+    wtd = match[1];
+
+    // Wt refuses a script request whose sid is not the one it booted with,
+    // so take the url from the bootstrap page rather than building it
+    auto target = "/?wtd=" + wtd + "&request=script";
+    if (std::regex_search(bootstrap.raw, match, script_url)) {
+      target = std::regex_replace(match[1].str(), std::regex("&amp;"), "&");
+      if (target[0] != '/') {
+        target.insert(0, "/");
+      }
+    }
+    if (target.find("sid=") == std::string::npos &&
+        std::regex_search(bootstrap.raw, match, script_id)) {
+      target += "&sid=" + match[1].str();
+    }
+
+    auto script = Request("load", target, "");
+    Scrape(script);
+    return script.status == 200;
+  }
+
+  /**
+   * @brief take the next step of the race script
+   *
+   * One step is one click: generate, a place or accept.  A step whose button
+   * was not found is recorded as "lost" and the race is generated again.
+   */
+  void Operate() {
+    if (heat < 0) {
+      Generate();
+      return;
+    }
+
+    auto prefix = "d0-h" + std::to_string(heat) + "-";
+    if (places.empty()) {
+      auto lanes{0};
+      while (buttons.count(prefix + "l" + std::to_string(lanes) + "-p0")) {
+        lanes++;
+      }
+      if (lanes == 0) {
+        // past the last heat the race is over; a missing first heat is not
+        if (heat == 0) {
+          log.Record("lost", 0, HttpResponse());
+        }
+        Generate();
+        return;
+      }
+      for (int place = 0; place < lanes; place++) {
+        places.emplace_back(place);
+      }
+      std::shuffle(places.begin(), places.end(), random);
+      lane = 0;
+    }
+
+    if (lane < places.size()) {
+      auto name = prefix + "l" + std::to_string(lane) + "-p" +
+                  std::to_string(places[lane]);
+      lane++;
+      Click("place", name);
+      return;
+    }
+
+    Click("accept", prefix + "accept");
+
+    // the accepted heat's buttons are gone or disabled from here on
+    auto it = buttons.lower_bound(prefix);
+    while (it != buttons.end() &&
+           it->first.compare(0, prefix.size(), prefix) == 0) {
+      it = buttons.erase(it);
+    }
+    places.clear();
+    heat++;
+  }
+
+  /**
+   * @brief ask the server for pending changes without sending an event
+   */
+  void Poll() { Scrape(Update("poll", "")); }
+
+ private:
+  /**
+   * @brief click "Generate schedule" and start over at the first heat
+   */
+  void Generate() {
+    // every lineup is rebuilt, so only the generate button survives
+    for (auto it = buttons.begin(); it != buttons.end();) {
+      it = it->first == "generate" ? std::next(it) : buttons.erase(it);
+    }
+    places.clear();
+    heat = 0;
+    Click("generate", "generate");
+  }
+
+  /**
+   * @brief send the signal of a named button
+   * @param kind latency log category
+   * @param name object name of the button
+   */
+  void Click(const std::string &kind, const std::string &name) {
+    auto button = buttons.find(name);
+    if (button == buttons.end()) {
+      log.Record("lost", 0, HttpResponse());
+      heat = -1;
+      Poll();
+      return;
+    }
+    Scrape(Update(kind, "&signal=" + button->second));
+  }
+
+  /**
+   * @brief send a jsupdate request for this session
+   * @param kind latency log category
+   * @param event extra form fields describing the event, if any
+   * @return the response
+   */
+  HttpResponse Update(const std::string &kind, const std::string &event) {
+    return Request(kind, "/?wtd=" + wtd,
+                   "request=jsupdate&pageId=0&ackId=" + std::to_string(ack_id) +
+                       event);
+  }
+
+  /**
+   * @brief send a request and record its latency
+   * @param kind latency log category
+   * @param target path and query string
+   * @param body form body, or "" to send a GET
+   * @return the response
+   */
+  HttpResponse Request(const std::string &kind, const std::string &target,
+                       const std::string &body) {
+    auto start = std::chrono::steady_clock::now();
+    auto response =
+        body.empty() ? client.Get(target) : client.Post(target, body);
+    log.Record(kind,
+               std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+                   .count(),
+               response);
+    return response;
+  }
+
+  /**
+   * @brief pick up the update id and named buttons from a response
+   *
+   * The response is cut at every element the server creates, either as
+   * markup or with document.createElement, and an element carrying both an
+   * object name and a signal is recorded as a button.
+   *
+   * @param response a script or jsupdate response
+   */
+  void Scrape(const HttpResponse &response) {
+    static const std::regex update_id("\\.response\\((\\d+)\\)");
+    static const std::regex element("createElement\\(|<[A-Za-z]");
+    static const std::regex object_name(
+        "data-object-name[^A-Za-z0-9]+([A-Za-z0-9-]+)");
+    static const std::regex signal("'(s[0-9a-f]+)'");
+
+    const auto &raw = response.raw;
+    std::smatch match;
+    if (std::regex_search(raw, match, update_id)) {
+      ack_id = std::stoi(match[1]);
+    }
+
+    auto starts = std::vector<size_t>();
+    for (auto it = std::sregex_iterator(raw.begin(), raw.end(), element);
+         it != std::sregex_iterator(); ++it) {
+      starts.emplace_back(it->position());
+    }
+    starts.emplace_back(raw.size());
+
+    for (size_t i = 0; i + 1 < starts.size(); i++) {
+      auto begin = raw.begin() + static_cast<std::ptrdiff_t>(starts[i]);
+      auto end = raw.begin() + static_cast<std::ptrdiff_t>(starts[i + 1]);
+      std::smatch name, sent;
+      if (std::regex_search(begin, end, name, object_name) &&
+          std::regex_search(begin, end, sent, signal)) {
+        buttons[name[1]] = sent[1];
+      }
+    }
+  }
+
+  /// @brief connection to the server
+  HttpClient client;
+
+  /// @brief shared latency log
+  LatencyLog &log;
+
+  /// @brief chooses the order places are handed out
+  std::mt19937 random;
+
+  /// @brief Wt session id
+  std::string wtd;
+
+  /// @brief id of the last update received from the server
+  int ack_id = 0;
+
+  /// @brief signals of the named buttons seen, keyed by object name
+  std::map<std::string, std::string> buttons;
+
+  /// @brief heat being entered, or -1 before the schedule is generated
+  int heat = -1;
+
+  /// @brief place given to each lane of the heat, empty between heats
+  std::vector<int> places;
+
+  /// @brief next lane of the heat to place
+  int lane = 0;
+};
+
+/**
+ * @brief read the resident set size of a process
+ * @param pid the process to inspect
+ * @return resident memory in KiB, or 0 if unavailable
+ */
+int64_t ReadRssKib(const int pid) {
+  auto status = std::ifstream("/proc/" + std::to_string(pid) + "/status");
+  auto line{std::string()};
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmRSS:") == 0) {
+      return std::atoll(line.c_str() + 6);
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief parse command line flags of the form --name value
+ * @param argc argument count
+ * @param argv argument values
+ * @param options populated with parsed values
+ * @return false if the flags could not be parsed
+ */
+bool ParseOptions(const int argc, char **argv, DriverOptions &options) {
+  try {
+    for (int i = 1; i + 1 < argc; i += 2) {
+      auto flag = std::string(argv[i]);
+      auto value = std::string(argv[i + 1]);
+      if (flag == "--host") {
+        options.host = value;
+      } else if (flag == "--port") {
+        options.port = value;
+      } else if (flag == "--operators") {
+        options.operators = std::stoi(value);
+      } else if (flag == "--idle-spectators") {
+        options.idle_spectators = std::stoi(value);
+      } else if (flag == "--polling-spectators") {
+        options.polling_spectators = std::stoi(value);
+      } else if (flag == "--duration") {
+        options.duration = std::stoi(value);
+      } else if (flag == "--think-ms") {
+        options.think_ms = std::stoi(value);
+      } else if (flag == "--poll-ms") {
+        options.poll_ms = std::stoi(value);
+      } else if (flag == "--pid") {
+        options.pid = std::stoi(value);
+      } else {
+        return false;
+      }
+    }
+  } catch (std::logic_error const &error) {
+    return false;
+  }
+  return argc % 2 == 1 && options.duration > 0 && options.think_ms > 0 &&
+         options.poll_ms > 0;
+}
+
+int main(int argc, char **argv) {
+  auto options = DriverOptions();
+  if (!ParseOptions(argc, argv, options)) {
+    std::cerr << "usage: " << argv[0]
+              << " [--host h] [--port p] [--operators n]"
+                 " [--idle-spectators n] [--polling-spectators n]"
+                 " [--duration s] [--think-ms ms] [--poll-ms ms] [--pid pid]"
+              << std::endl;
+    return 1;
+  }
+
+  auto log = LatencyLog();
+  auto running = std::atomic<bool>(true);
+  auto failed_sessions = std::atomic<int>(0);
+
+  // each simulated user paces itself; jitter the first action so the
+  // sessions do not all hit the server in lockstep
+  auto simulate = [&](const unsigned int seed, const int interval_ms,
+                      const bool clicks, const bool polls) {
+    auto browser = SimulatedBrowser(options, log, seed);
+    if (!browser.Start()) {
+      failed_sessions++;
+      return;
+    }
+    auto random = std::mt19937(seed);
+    auto jitter = std::uniform_int_distribution<int>(0, interval_ms);
+    auto next = std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(jitter(random));
+    while (running) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      if (std::chrono::steady_clock::now() < next) {
+        continue;
+      }
+      if (clicks) {
+        browser.Operate();
+      } else if (polls) {
+        browser.Poll();
+      }
+      next += std::chrono::milliseconds(interval_ms);
+    }
+  };
+
+  auto start_rss = options.pid ? ReadRssKib(options.pid) : 0;
+  auto start = std::chrono::steady_clock::now();
+
+  auto users = std::vector<std::thread>();
+  auto seed{1u};
+  for (int i = 0; i < options.operators; i++) {
+    users.emplace_back(simulate, seed++, options.think_ms, true, false);
+  }
+  for (int i = 0; i < options.polling_spectators; i++) {
+    users.emplace_back(simulate, seed++, options.poll_ms, false, true);
+  }
+  for (int i = 0; i < options.idle_spectators; i++) {
+    users.emplace_back(simulate, seed++, options.poll_ms, false, false);
+  }
+
+  // sample server memory once a second while the load runs
+  auto peak_rss = start_rss;
+  for (int second = 0; second < options.duration; second++) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    if (options.pid) {
+      peak_rss = std::max(peak_rss, ReadRssKib(options.pid));
+    }
+  }
+  running = false;
+  for (auto &user : users) {
+    user.join();
+  }
+
+  auto seconds = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+
+  std::cout << "racingweb load: " << options.operators << " operators, "
+            << options.polling_spectators << " polling spectators, "
+            << options.idle_spectators << " idle spectators, "
+            << std::fixed << std::setprecision(1) << seconds << "s"
+            << std::endl;
+  if (failed_sessions > 0) {
+    std::cout << failed_sessions << " sessions failed to start" << std::endl;
+  }
+  std::cout << std::endl;
+  log.Report(std::cout, seconds);
+
+  if (options.pid) {
+    std::cout << std::endl
+              << "server rss (KiB): start " << start_rss << ", peak "
+              << peak_rss << ", end " << ReadRssKib(options.pid) << std::endl;
+  }
+
+  return 0;
+}
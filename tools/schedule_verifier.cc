@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/Car.h"
+#include "src/HeatStream.h"
+#include "src/ScheduleAnalyzer.h"
+#include "src/schedule.h"
+
+/**
+ * @brief generate a schedule the same way a division does
+ * @param roster the cars to race
+ * @param lanes number of lanes
+ * @param rounds how many times each car races in each lane
+ * @return every heat of the schedule
+ */
+RaceSchedule GenerateFullSchedule(const std::vector<Car> &roster,
+                                  const int lanes, const int rounds) {
+  if (rounds == 1) {
+    return GenerateRaceSchedule(roster, lanes);
+  }
+
+  auto schedule = RaceSchedule();
+  auto heat_stream = HeatStream(roster, lanes, rounds);
+  for (auto heat = heat_stream.Next(); !heat.empty();
+       heat = heat_stream.Next()) {
+    schedule.emplace_back(heat.begin(), heat.end());
+  }
+  return schedule;
+}
+
+/**
+ * @brief time random heat swaps on a large schedule
+ * @param out where to write the timing
+ */
+void BenchmarkSwaps(std::ostream &out) {
+  constexpr int kCars = 200, kLanes = 4, kSwaps = 1'000'000;
+
+  auto roster = std::vector<Car>();
+  for (int i = 0; i < kCars; i++) {
+    roster.emplace_back(i + 1);
+  }
+  auto analyzer =
+      ScheduleAnalyzer(roster, GenerateRaceSchedule(roster, kLanes));
+
+  auto random = std::mt19937(1);
+  auto pick = std::uniform_int_distribution<int>(0, kCars - 1);
+  auto start = std::chrono::steady_clock::now();
+  auto checksum{0.0};
+  for (int i = 0; i < kSwaps; i++) {
+    analyzer.SwapHeats(pick(random), pick(random));
+    checksum += analyzer.BalanceScore();
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - start);
+
+  out << kSwaps << " swaps of a " << kCars << " car, " << kLanes
+      << " lane schedule: " << std::fixed << std::setprecision(1)
+      << elapsed.count() / kSwaps << " ns per swap and score (checksum "
+      << checksum << ")" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  int max_cars{64}, max_lanes{8}, max_rounds{3};
+  auto verbose{false};
+
+  try {
+    for (int i = 1; i < argc; i++) {
+      auto arg = std::string(argv[i]);
+      if (arg == "--verbose") {
+        verbose = true;
+      } else if (arg == "--max-cars" && i + 1 < argc) {
+        max_cars = std::stoi(argv[++i]);
+      } else if (arg == "--max-lanes" && i + 1 < argc) {
+        max_lanes = std::stoi(argv[++i]);
+      } else if (arg == "--max-rounds" && i + 1 < argc) {
+        max_rounds = std::stoi(argv[++i]);
+      } else {
+        throw std::invalid_argument(arg);
+      }
+    }
+  } catch (std::logic_error const &error) {
+    std::cerr << "usage: " << argv[0]
+              << " [--max-cars n] [--max-lanes n] [--max-rounds n] [--verbose]"
+              << std::endl;
+    return 1;
+  }
+
+  // check every combination the setup tab accepts, lanes capped at cars
+  auto failures{0}, combinations{0};
+  for (int cars = 1; cars <= max_cars; cars++) {
+    auto roster = std::vector<Car>();
+    for (int i = 0; i < cars; i++) {
+      roster.emplace_back(i + 1);
+    }
+
+    for (int lanes = 1; lanes <= max_lanes && lanes <= cars; lanes++) {
+      for (int rounds = 1; rounds <= max_rounds; rounds++) {
+        auto analyzer = ScheduleAnalyzer(
+            roster, GenerateFullSchedule(roster, lanes, rounds));
+        auto problems = analyzer.Verify(lanes, rounds);
+        combinations++;
+
+        if (!problems.empty()) {
+          failures++;
+          std::cout << cars << " cars, " << lanes << " lanes, " << rounds
+                    << " rounds: FAILED" << std::endl;
+          for (const auto &problem : problems) {
+            std::cout << "  " << problem << std::endl;
+          }
+        } else if (verbose) {
+          std::cout << cars << " cars, " << lanes << " lanes, " << rounds
+                    << " rounds: ok, " << analyzer.BackToBack()
+                    << " back-to-back, balance " << std::fixed
+                    << std::setprecision(3) << analyzer.BalanceScore()
+                    << std::endl;
+        }
+      }
+    }
+  }
+
+  std::cout << combinations - failures << " of " << combinations
+            << " schedules meet every guarantee" << std::endl;
+
+  BenchmarkSwaps(std::cout);
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,292 @@
+// Copyright (c) 2026 Cameron King.
+// Dual licensed under MIT and GPLv2 with OpenSSL exception.
+// See LICENSE for details.
+/// @file
+
+#include <Wt/Test/WTestEnvironment.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "src/RacingWebApplication.h"
+
+/**
+ * @brief runs scripted RacingWebApplication sessions without a browser
+ *
+ * Each session is created against a Wt::Test::WTestEnvironment, generates a
+ * schedule, marks every place in every heat, accepts every heat and renders
+ * the final standings.  The ui handlers are called the same way the signal
+ * connections in RacingWebApplication call them, and the on-deck timer is
+ * fired by hand since the test environment has no event loop.
+ */
+class SessionBench {
+ public:
+  /**
+   * @brief prepare a benchmark
+   * @param cars number of cars in each scripted race
+   * @param lanes number of lanes in each scripted race
+   * @param sessions how many sessions to create and run to completion
+   */
+  SessionBench(const int cars, const int lanes, const int sessions)
+      : cars(cars), lanes(lanes), sessions(sessions) {}
+
+  /**
+   * @brief run every session and write a report
+   * @param out where to write the report
+   */
+  void Run(std::ostream &out) {
+    for (int i = 0; i < sessions; i++) {
+      RunSession();
+    }
+    Report(out);
+  }
+
+ private:
+  /// @brief clock used for all handler timings
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief size of the rendered widget tree at one point in the script
+  struct RenderSample {
+    /// @brief number of elements carrying a widget id
+    size_t widgets = 0;
+    /// @brief bytes of html needed to render the whole tree
+    size_t bytes = 0;
+  };
+
+  /// @brief race arena usage of one session
+  struct ArenaSample {
+    /// @brief allocations served by the session's arenas
+    uint64_t allocations = 0;
+    /// @brief heap memory held by the session's arenas
+    size_t bytes = 0;
+  };
+
+  /**
+   * @brief create one session and script a full race through it
+   */
+  void RunSession() {
+    auto start = Clock::now();
+    auto env = std::make_unique<Wt::Test::WTestEnvironment>();
+    auto app = std::make_unique<RacingWebApplication>(*env);
+    Record("session creation", start);
+
+    app->number_of_cars->setText(std::to_string(cars));
+    app->number_of_lanes->setText(std::to_string(lanes));
+
+    start = Clock::now();
+    app->GenerateSchedule();
+    Record("GenerateSchedule", start);
+    Sample("after generate", *app);
+
+    while (app->IdentifyNextHeat() >= 0) {
+      auto heat = app->current_heat;
+      const auto &schedule = app->CurrentDivision().schedule;
+      auto heat_lanes = static_cast<int>(schedule[heat].size());
+
+      // the timer SetCurrentHeat starts builds the on-deck lineup
+      start = Clock::now();
+      app->PrepareOnDeckLineup();
+      Record("PrepareOnDeckLineup", start);
+
+      // rotate the finishing order so every lane sees every place
+      for (int lane = 0; lane < heat_lanes; lane++) {
+        auto place = (lane + heat) % heat_lanes;
+        start = Clock::now();
+        app->MarkPlace(*schedule[heat][lane], lane, place);
+        Record("MarkPlace", start);
+      }
+      Sample("heat marked", *app);
+
+      // accepting calls SetCurrentHeat, which swaps in the on-deck lineup
+      start = Clock::now();
+      app->AcceptResults();
+      Record("AcceptResults", start);
+    }
+
+    start = Clock::now();
+    app->UpdateStandingsContainer();
+    Record("UpdateStandingsContainer", start);
+    Sample("finished", *app);
+
+    // what the race arenas served and hold just before the session closes
+    auto arena = ArenaSample();
+    for (const auto &division : app->tournament.Divisions()) {
+      arena.allocations += division->arena.Allocations();
+      arena.bytes += division->arena.BytesReserved();
+    }
+    arena_samples.emplace_back(arena);
+
+    start = Clock::now();
+    app.reset();
+    env.reset();
+    Record("session teardown", start);
+  }
+
+  /**
+   * @brief add a timing measured from start until now
+   * @param handler name the timing is reported under
+   * @param start when the measured call began
+   */
+  void Record(const std::string &handler, const Clock::time_point start) {
+    auto elapsed =
+        std::chrono::duration<double, std::micro>(Clock::now() - start);
+    if (timings.find(handler) == timings.end()) {
+      timing_order.emplace_back(handler);
+    }
+    timings[handler].emplace_back(elapsed.count());
+  }
+
+  /**
+   * @brief estimate the widget count and response size of the session
+   *
+   * The whole widget tree is rendered as html.  A browser only receives the
+   * changed part of the tree, so this is an upper bound on a single response.
+   * @param stage name the sample is reported under
+   * @param app the session to sample
+   */
+  void Sample(const std::string &stage, RacingWebApplication &app) {
+    auto html{std::stringstream()};
+    app.root()->htmlText(html);
+    auto rendered = html.str();
+
+    auto sample = RenderSample();
+    sample.bytes = rendered.size();
+    for (auto pos = rendered.find(" id=\""); pos != std::string::npos;
+         pos = rendered.find(" id=\"", pos + 1)) {
+      sample.widgets++;
+    }
+
+    if (samples.find(stage) == samples.end()) {
+      sample_order.emplace_back(stage);
+    }
+    samples[stage].emplace_back(sample);
+  }
+
+  /**
+   * @brief write latency percentiles and render sizes
+   * @param out where to write the report
+   */
+  void Report(std::ostream &out) {
+    out << "racingweb session benchmark: " << sessions << " sessions, " << cars
+        << " cars, " << lanes << " lanes" << std::endl
+        << std::endl;
+
+    out << std::left << std::setw(26) << "handler (us)" << std::right
+        << std::setw(8) << "calls" << std::setw(10) << "mean" << std::setw(10)
+        << "p50" << std::setw(10) << "p95" << std::setw(10) << "max"
+        << std::endl;
+    out << std::fixed << std::setprecision(1);
+    for (const auto &handler : timing_order) {
+      auto &values = timings[handler];
+      std::sort(values.begin(), values.end());
+      auto sum{0.0};
+      for (const auto &value : values) {
+        sum += value;
+      }
+      out << std::left << std::setw(26) << handler << std::right
+          << std::setw(8) << values.size() << std::setw(10)
+          << sum / values.size() << std::setw(10) << Percentile(values, 50)
+          << std::setw(10) << Percentile(values, 95) << std::setw(10)
+          << values.back() << std::endl;
+    }
+
+    out << std::endl
+        << std::left << std::setw(26) << "render" << std::right
+        << std::setw(8) << "samples" << std::setw(10) << "widgets"
+        << std::setw(10) << "bytes" << std::endl;
+    for (const auto &stage : sample_order) {
+      const auto &values = samples[stage];
+      auto widgets{0.0}, bytes{0.0};
+      for (const auto &sample : values) {
+        widgets += sample.widgets;
+        bytes += sample.bytes;
+      }
+      out << std::left << std::setw(26) << stage << std::right
+          << std::setw(8) << values.size() << std::setw(10)
+          << widgets / values.size() << std::setw(10) << bytes / values.size()
+          << std::endl;
+    }
+
+    auto allocations{0.0}, bytes{0.0};
+    for (const auto &sample : arena_samples) {
+      allocations += sample.allocations;
+      bytes += sample.bytes;
+    }
+    out << std::endl
+        << "race arenas per session: " << allocations / arena_samples.size()
+        << " allocations, " << bytes / arena_samples.size() / 1024
+        << " KiB held at finish" << std::endl;
+  }
+
+  /**
+   * @brief nearest-rank percentile of sorted values
+   * @param values sorted, non-empty values
+   * @param percent which percentile, 0 < percent <= 100
+   * @return the percentile value
+   */
+  static double Percentile(const std::vector<double> &values,
+                           const int percent) {
+    auto rank = (values.size() * percent + 99) / 100;
+    return values[rank > 0 ? rank - 1 : 0];
+  }
+
+  /// @brief number of cars in each scripted race
+  int cars;
+
+  /// @brief number of lanes in each scripted race
+  int lanes;
+
+  /// @brief number of sessions to run
+  int sessions;
+
+  /// @brief handler timings in microseconds, keyed by handler name
+  std::map<std::string, std::vector<double>> timings;
+
+  /// @brief handler names in the order they were first recorded
+  std::vector<std::string> timing_order;
+
+  /// @brief render samples keyed by script stage
+  std::map<std::string, std::vector<RenderSample>> samples;
+
+  /// @brief stage names in the order they were first sampled
+  std::vector<std::string> sample_order;
+
+  /// @brief race arena usage of every session, at finish
+  std::vector<ArenaSample> arena_samples;
+};
+
+int main(int argc, char **argv) {
+  int cars{12}, lanes{4}, sessions{20};
+
+  try {
+    if (argc > 1) {
+      cars = std::stoi(argv[1]);
+    }
+    if (argc > 2) {
+      lanes = std::stoi(argv[2]);
+    }
+    if (argc > 3) {
+      sessions = std::stoi(argv[3]);
+    }
+  } catch (std::logic_error const &error) {
+    std::cerr << "usage: " << argv[0] << " [cars] [lanes] [sessions]"
+              << std::endl;
+    return 1;
+  }
+
+  if (cars < 1 || lanes < 1 || sessions < 1) {
+    std::cerr << "cars, lanes and sessions must be positive" << std::endl;
+    return 1;
+  }
+
+  SessionBench(cars, lanes, sessions).Run(std::cout);
+  return 0;
+}